@@ -0,0 +1,777 @@
+#ifndef ARBOLBMAS_H
+#define ARBOLBMAS_H
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "RegistroEstudiante.h"
+
+using namespace std;
+
+/**
+ * Claves por nodo del arbol B+
+ * 16 claves int ocupan 64 bytes: una linea de cache por nodo al comparar
+ */
+const int ORDEN_BMAS = 16;
+
+/**
+ * Estructura NodoBMas: nodo del arbol B+ (hoja o interno)
+ *
+ * CAMPOS:
+ * - claves: claves ordenadas del nodo (numClaves en uso)
+ * - valores: en una hoja, el id_info de cada clave;
+ *            en un nodo interno, los numClaves + 1 hijos
+ * - hoja: true si el nodo es una hoja
+ * - anterior / siguiente: hojas vecinas (-1 en los extremos)
+ */
+struct NodoBMas{
+    int claves[ORDEN_BMAS];         // Claves ordenadas
+    int valores[ORDEN_BMAS + 1];    // id_info (hoja) o hijos (interno)
+    int numClaves;                  // Claves en uso
+    bool hoja;                      // Tipo de nodo
+    int anterior;                   // Hoja anterior
+    int siguiente;                  // Hoja siguiente
+
+    // Constructor por defecto: hoja vacia sin vecinos
+    NodoBMas(): numClaves(0), hoja(true), anterior(-1), siguiente(-1) {}
+};
+
+/**
+ * Clase ArbolBMas
+ *
+ * Motor alternativo de ArbolBinarioOrdenado: arbol B+ de pares (clave, id_info).
+ *
+ * CARACTERiSTICAS:
+ * - Varias claves por nodo: una busqueda recorre log16(n) nodos en lugar
+ *   de log2(n), con menos saltos dependientes en memoria
+ * - Todas las entradas estan en las hojas, enlazadas en ambos sentidos:
+ *   el recorrido inorden es un barrido secuencial de hojas
+ * - Siempre balanceado: division al insertar, prestamo o fusion al eliminar
+ * - Los nodos viven en un vector y se enlazan por indice, igual que el
+ *   arreglo del arbol binario (los nodos liberados se reutilizan)
+ *
+ * FORMATO DEL ARCHIVO:
+ * - "ABM1", capacidad y numero de entradas (varint)
+ * - Entradas en orden: ZigZag(diferencia de clave) y ZigZag(diferencia de id_info)
+ * - CRC-32 de las entradas (u32)
+ */
+class ArbolBMas{
+private:
+    vector<NodoBMas> nodos;         // Todos los nodos (hojas e internos)
+    vector<int> libres;             // Nodos liberados para reutilizar
+    int raiz;                       // indice del nodo raiz (-1 si vacio)
+    int primeraHoja;                // Hoja con las claves menores
+    int ultimaHoja;                 // Hoja con las claves mayores
+    int cantidad;                   // Entradas almacenadas
+    int capacidad;                  // Maximo de entradas
+
+    // Reserva un nodo (reutilizando uno libre si hay). Invalida referencias a 'nodos'
+    int nuevoNodo(bool hoja);
+    void liberarNodo(int indice);
+
+    // Posicion de la primera clave >= clave (busqueda lineal en la linea de cache)
+    // Ambas cuentan sus comparaciones si se compila con ARBOL_ESTADISTICAS
+    int posicionEnNodo(const NodoBMas& nodo, int clave);
+
+    // Hijo que corresponde a la clave en un nodo interno
+    int hijoPara(const NodoBMas& nodo, int clave);
+
+    /**
+     * Baja desde la raiz hasta la hoja que corresponde a la clave
+     * PARaMETROS:
+     * - camino: si no es nulo, se llena con (nodo interno, hijo tomado)
+     * RETORNA: indice de la hoja
+     */
+    int descender(int clave, vector<pair<int, int>>* camino);
+
+    // Sube un separador y el nuevo nodo derecho, dividiendo padres llenos
+    void insertarEnPadre(vector<pair<int, int>>& camino, int separador, int derecho);
+
+    // Corrige un nodo con menos de ORDEN_BMAS/2 claves tras eliminar
+    void repararSubllenado(vector<pair<int, int>>& camino, int nodo);
+
+    // Mueve una entrada del hermano izquierdo/derecho al hijo 'i' del padre
+    void prestarDeIzquierda(int padre, int i);
+    void prestarDeDerecha(int padre, int i);
+
+    // Une el hijo k+1 del padre dentro del hijo k
+    void fusionarHijos(int padre, int k);
+
+public:
+#ifdef ARBOL_ESTADISTICAS
+    unsigned long long comparaciones;   // Comparaciones de claves dentro de los nodos
+    unsigned long long nodosVisitados;  // Un nodo por nivel al descender, mas las hojas barridas
+#endif
+
+    /**
+     * Constructor: arbol vacio con capacidad para n entradas
+     */
+    ArbolBMas(int n);
+
+    /**
+     * Inserta una entrada
+     * RETORNA: false si el arbol esta lleno o la clave ya existe
+     */
+    bool insertar(int clave, int id_info);
+
+    /**
+     * Busca una clave
+     * RETORNA: true y el id_info en 'id_info' si existe
+     */
+    bool buscar(int clave, int& id_info);
+
+    /**
+     * Cambia el id_info de una clave existente
+     * RETORNA: true y el id_info anterior en 'anterior' si la clave existe
+     */
+    bool reemplazar(int clave, int nuevoId, int& anterior);
+
+    /**
+     * Elimina una clave
+     * RETORNA: true y su id_info en 'id_info' si la clave existia
+     */
+    bool eliminar(int clave, int& id_info);
+
+    /**
+     * Clave mas cercana a 'clave' en una direccion
+     * PARaMETROS:
+     * - haciaArriba: true = menor clave mayor (techo/sucesor),
+     *   false = mayor clave menor (piso/predecesor)
+     * - incluirIgual: si la propia clave cuenta como resultado
+     * RETORNA: true y la clave en 'resultado' si existe
+     * 
+     * COSTO: un descenso y, a lo sumo, un salto a la hoja vecina
+     */
+    bool vecino(int clave, bool haciaArriba, bool incluirIgual, int& resultado);
+
+    /**
+     * Las k claves menores (en orden ascendente) o las k mayores (en orden
+     * descendente), siguiendo la lista de hojas desde un extremo
+     */
+    vector<int> extremos(int k, bool desdeElMayor);
+
+    /**
+     * Entradas (clave, id_info) en orden ascendente, barriendo las hojas
+     */
+    vector<pair<int, int>> entradas();
+
+    /**
+     * Reemplaza el contenido por entradas ya ordenadas y sin repetidos
+     * Construye el arbol de abajo hacia arriba en O(n), con las hojas
+     * llenas a 3/4 para dejar espacio a inserciones futuras
+     * RETORNA: false si no caben en la capacidad
+     */
+    bool construirDesdeOrdenado(const vector<pair<int, int>>& ordenadas);
+
+    // Elimina todas las entradas
+    void vaciar();
+
+    // Informacion de forma
+    int numeroEntradas();
+    int capacidadMaxima();
+    bool lleno();
+    int altura();
+    int numeroHojas();
+
+    /**
+     * Persistencia en archivo binario
+     * RETORNAN: true si la operacion fue exitosa
+     */
+    bool guardar(const string& archivo);
+    bool cargar(const string& archivo);
+};
+
+// ===============================
+// IMPLEMENTACIoN DEL ARBOL B+
+// ===============================
+
+ArbolBMas::ArbolBMas(int n): raiz(-1), primeraHoja(-1), ultimaHoja(-1), cantidad(0), capacidad(n){
+#ifdef ARBOL_ESTADISTICAS
+    comparaciones = 0;
+    nodosVisitados = 0;
+#endif
+}
+
+int ArbolBMas::nuevoNodo(bool hoja){
+    int indice;
+    if(!libres.empty()){
+        indice = libres.back();                   // Reutilizar nodo liberado
+        libres.pop_back();
+        nodos[indice] = NodoBMas();
+    }
+    else{
+        indice = nodos.size();
+        nodos.push_back(NodoBMas());
+    }
+    nodos[indice].hoja = hoja;
+    return indice;
+}
+
+void ArbolBMas::liberarNodo(int indice){
+    libres.push_back(indice);
+}
+
+int ArbolBMas::posicionEnNodo(const NodoBMas& nodo, int clave){
+    int i = 0;
+    while(i < nodo.numClaves && nodo.claves[i] < clave) i++;
+#ifdef ARBOL_ESTADISTICAS
+    comparaciones += i < nodo.numClaves ? i + 1 : i;  // Tambien la que detuvo la busqueda
+#endif
+    return i;
+}
+
+int ArbolBMas::hijoPara(const NodoBMas& nodo, int clave){
+    // Claves >= separador van al hijo de la derecha del separador
+    int i = 0;
+    while(i < nodo.numClaves && nodo.claves[i] <= clave) i++;
+#ifdef ARBOL_ESTADISTICAS
+    comparaciones += i < nodo.numClaves ? i + 1 : i;
+#endif
+    return i;
+}
+
+int ArbolBMas::descender(int clave, vector<pair<int, int>>* camino){
+    int actual = raiz;
+#ifdef ARBOL_ESTADISTICAS
+    nodosVisitados++;                             // La raiz
+#endif
+    while(!nodos[actual].hoja){
+        int i = hijoPara(nodos[actual], clave);
+        if(camino) camino->push_back({actual, i});
+        actual = nodos[actual].valores[i];
+#ifdef ARBOL_ESTADISTICAS
+        nodosVisitados++;                         // Un nodo por nivel
+#endif
+    }
+    return actual;
+}
+
+bool ArbolBMas::buscar(int clave, int& id_info){
+    if(raiz == -1) return false;
+    NodoBMas& hoja = nodos[descender(clave, nullptr)];
+    int pos = posicionEnNodo(hoja, clave);
+    if(pos < hoja.numClaves && hoja.claves[pos] == clave){
+        id_info = hoja.valores[pos];
+        return true;
+    }
+    return false;
+}
+
+bool ArbolBMas::reemplazar(int clave, int nuevoId, int& anterior){
+    if(raiz == -1) return false;
+    NodoBMas& hoja = nodos[descender(clave, nullptr)];
+    int pos = posicionEnNodo(hoja, clave);
+    if(pos < hoja.numClaves && hoja.claves[pos] == clave){
+        anterior = hoja.valores[pos];
+        hoja.valores[pos] = nuevoId;
+        return true;
+    }
+    return false;
+}
+
+bool ArbolBMas::insertar(int clave, int id_info){
+    if(cantidad >= capacidad) return false;       // Arbol lleno
+
+    if(raiz == -1){                               // Primer elemento: raiz hoja
+        raiz = nuevoNodo(true);
+        primeraHoja = ultimaHoja = raiz;
+    }
+
+    // PASO 1: Bajar hasta la hoja guardando el camino
+    vector<pair<int, int>> camino;
+    int hoja = descender(clave, &camino);
+    NodoBMas* h = &nodos[hoja];
+    int pos = posicionEnNodo(*h, clave);
+    if(pos < h->numClaves && h->claves[pos] == clave){
+        return false;                             // Clave duplicada
+    }
+    cantidad++;
+
+    // PASO 2: Hay espacio en la hoja: desplazar e insertar
+    if(h->numClaves < ORDEN_BMAS){
+        for(int j = h->numClaves; j > pos; j--){
+            h->claves[j] = h->claves[j - 1];
+            h->valores[j] = h->valores[j - 1];
+        }
+        h->claves[pos] = clave;
+        h->valores[pos] = id_info;
+        h->numClaves++;
+        return true;
+    }
+
+    // PASO 3: Hoja llena: repartir ORDEN_BMAS + 1 entradas en dos hojas
+    int tmpClaves[ORDEN_BMAS + 1], tmpValores[ORDEN_BMAS + 1];
+    for(int j = 0, k = 0; j <= ORDEN_BMAS; j++){
+        if(j == pos){
+            tmpClaves[j] = clave;
+            tmpValores[j] = id_info;
+        }
+        else{
+            tmpClaves[j] = h->claves[k];
+            tmpValores[j] = h->valores[k];
+            k++;
+        }
+    }
+
+    int nueva = nuevoNodo(true);
+    h = &nodos[hoja];                             // nuevoNodo pudo mover el vector
+    NodoBMas& derecha = nodos[nueva];
+    int mitad = (ORDEN_BMAS + 1) / 2;
+    h->numClaves = mitad;
+    derecha.numClaves = ORDEN_BMAS + 1 - mitad;
+    for(int j = 0; j < mitad; j++){
+        h->claves[j] = tmpClaves[j];
+        h->valores[j] = tmpValores[j];
+    }
+    for(int j = mitad; j <= ORDEN_BMAS; j++){
+        derecha.claves[j - mitad] = tmpClaves[j];
+        derecha.valores[j - mitad] = tmpValores[j];
+    }
+
+    // Enlazar la nueva hoja en la lista de hojas
+    derecha.anterior = hoja;
+    derecha.siguiente = h->siguiente;
+    if(h->siguiente != -1) nodos[h->siguiente].anterior = nueva;
+    else ultimaHoja = nueva;
+    h->siguiente = nueva;
+
+    // PASO 4: La primera clave de la hoja nueva sube como separador
+    insertarEnPadre(camino, derecha.claves[0], nueva);
+    return true;
+}
+
+void ArbolBMas::insertarEnPadre(vector<pair<int, int>>& camino, int separador, int derecho){
+    while(true){
+        if(camino.empty()){
+            // Se dividio la raiz: el arbol crece un nivel
+            int nuevaRaiz = nuevoNodo(false);
+            nodos[nuevaRaiz].claves[0] = separador;
+            nodos[nuevaRaiz].valores[0] = raiz;
+            nodos[nuevaRaiz].valores[1] = derecho;
+            nodos[nuevaRaiz].numClaves = 1;
+            raiz = nuevaRaiz;
+            return;
+        }
+
+        int padre = camino.back().first;
+        int i = camino.back().second;             // Hijo que se dividio
+        camino.pop_back();
+        NodoBMas* p = &nodos[padre];
+
+        if(p->numClaves < ORDEN_BMAS){            // Hay espacio en el padre
+            for(int j = p->numClaves; j > i; j--){
+                p->claves[j] = p->claves[j - 1];
+                p->valores[j + 1] = p->valores[j];
+            }
+            p->claves[i] = separador;
+            p->valores[i + 1] = derecho;
+            p->numClaves++;
+            return;
+        }
+
+        // Padre lleno: repartir ORDEN_BMAS + 1 claves; la del medio sube
+        int tmpClaves[ORDEN_BMAS + 1], tmpHijos[ORDEN_BMAS + 2];
+        for(int j = 0, k = 0; j <= ORDEN_BMAS; j++){
+            tmpClaves[j] = (j == i) ? separador : p->claves[k++];
+        }
+        for(int j = 0, k = 0; j <= ORDEN_BMAS + 1; j++){
+            tmpHijos[j] = (j == i + 1) ? derecho : p->valores[k++];
+        }
+
+        int nuevo = nuevoNodo(false);
+        p = &nodos[padre];                        // nuevoNodo pudo mover el vector
+        NodoBMas& derecha = nodos[nuevo];
+        int mitad = (ORDEN_BMAS + 1) / 2;
+        p->numClaves = mitad;
+        for(int j = 0; j < mitad; j++) p->claves[j] = tmpClaves[j];
+        for(int j = 0; j <= mitad; j++) p->valores[j] = tmpHijos[j];
+        derecha.numClaves = ORDEN_BMAS - mitad;
+        for(int j = mitad + 1; j <= ORDEN_BMAS; j++) derecha.claves[j - mitad - 1] = tmpClaves[j];
+        for(int j = mitad + 1; j <= ORDEN_BMAS + 1; j++) derecha.valores[j - mitad - 1] = tmpHijos[j];
+
+        separador = tmpClaves[mitad];             // Continuar un nivel arriba
+        derecho = nuevo;
+    }
+}
+
+bool ArbolBMas::eliminar(int clave, int& id_info){
+    if(raiz == -1) return false;
+
+    vector<pair<int, int>> camino;
+    int hoja = descender(clave, &camino);
+    NodoBMas& h = nodos[hoja];
+    int pos = posicionEnNodo(h, clave);
+    if(pos >= h.numClaves || h.claves[pos] != clave){
+        return false;                             // Clave no existe
+    }
+
+    id_info = h.valores[pos];
+    for(int j = pos; j < h.numClaves - 1; j++){
+        h.claves[j] = h.claves[j + 1];
+        h.valores[j] = h.valores[j + 1];
+    }
+    h.numClaves--;
+    cantidad--;
+
+    repararSubllenado(camino, hoja);
+    return true;
+}
+
+void ArbolBMas::repararSubllenado(vector<pair<int, int>>& camino, int nodo){
+    const int MINIMO = ORDEN_BMAS / 2;
+    while(true){
+        NodoBMas& n = nodos[nodo];
+        if(nodo == raiz){
+            if(n.numClaves == 0){
+                if(n.hoja){                       // Arbol vacio
+                    raiz = primeraHoja = ultimaHoja = -1;
+                }
+                else{                             // Raiz sin claves: baja un nivel
+                    raiz = n.valores[0];
+                }
+                liberarNodo(nodo);
+            }
+            return;
+        }
+        if(n.numClaves >= MINIMO) return;         // Nodo suficientemente lleno
+
+        int padre = camino.back().first;
+        int i = camino.back().second;
+        camino.pop_back();
+        NodoBMas& p = nodos[padre];
+        int izquierdo = i > 0 ? p.valores[i - 1] : -1;
+        int derecho = i < p.numClaves ? p.valores[i + 1] : -1;
+
+        // CASO 1 y 2: Un hermano tiene claves de sobra
+        if(izquierdo != -1 && nodos[izquierdo].numClaves > MINIMO){
+            prestarDeIzquierda(padre, i);
+            return;
+        }
+        if(derecho != -1 && nodos[derecho].numClaves > MINIMO){
+            prestarDeDerecha(padre, i);
+            return;
+        }
+
+        // CASO 3: Fusionar con un hermano; el padre pierde una clave
+        if(izquierdo != -1) fusionarHijos(padre, i - 1);
+        else                fusionarHijos(padre, i);
+        nodo = padre;                             // El padre pudo quedar subllenado
+    }
+}
+
+void ArbolBMas::prestarDeIzquierda(int padre, int i){
+    NodoBMas& p = nodos[padre];
+    NodoBMas& n = nodos[p.valores[i]];
+    NodoBMas& izq = nodos[p.valores[i - 1]];
+
+    if(n.hoja){
+        for(int j = n.numClaves; j > 0; j--){
+            n.claves[j] = n.claves[j - 1];
+            n.valores[j] = n.valores[j - 1];
+        }
+        n.claves[0] = izq.claves[izq.numClaves - 1];
+        n.valores[0] = izq.valores[izq.numClaves - 1];
+        p.claves[i - 1] = n.claves[0];            // Nuevo limite entre ambos
+    }
+    else{
+        for(int j = n.numClaves; j > 0; j--) n.claves[j] = n.claves[j - 1];
+        for(int j = n.numClaves + 1; j > 0; j--) n.valores[j] = n.valores[j - 1];
+        n.claves[0] = p.claves[i - 1];            // El separador baja
+        n.valores[0] = izq.valores[izq.numClaves];
+        p.claves[i - 1] = izq.claves[izq.numClaves - 1];  // La ultima del hermano sube
+    }
+    n.numClaves++;
+    izq.numClaves--;
+}
+
+void ArbolBMas::prestarDeDerecha(int padre, int i){
+    NodoBMas& p = nodos[padre];
+    NodoBMas& n = nodos[p.valores[i]];
+    NodoBMas& der = nodos[p.valores[i + 1]];
+
+    if(n.hoja){
+        n.claves[n.numClaves] = der.claves[0];
+        n.valores[n.numClaves] = der.valores[0];
+        for(int j = 0; j < der.numClaves - 1; j++){
+            der.claves[j] = der.claves[j + 1];
+            der.valores[j] = der.valores[j + 1];
+        }
+        n.numClaves++;
+        der.numClaves--;
+        p.claves[i] = der.claves[0];              // Nuevo limite entre ambos
+    }
+    else{
+        n.claves[n.numClaves] = p.claves[i];      // El separador baja
+        n.valores[n.numClaves + 1] = der.valores[0];
+        p.claves[i] = der.claves[0];              // La primera del hermano sube
+        for(int j = 0; j < der.numClaves - 1; j++) der.claves[j] = der.claves[j + 1];
+        for(int j = 0; j < der.numClaves; j++) der.valores[j] = der.valores[j + 1];
+        n.numClaves++;
+        der.numClaves--;
+    }
+}
+
+void ArbolBMas::fusionarHijos(int padre, int k){
+    NodoBMas& p = nodos[padre];
+    int indiceIzq = p.valores[k];
+    int indiceDer = p.valores[k + 1];
+    NodoBMas& izq = nodos[indiceIzq];
+    NodoBMas& der = nodos[indiceDer];
+
+    if(izq.hoja){
+        for(int j = 0; j < der.numClaves; j++){
+            izq.claves[izq.numClaves + j] = der.claves[j];
+            izq.valores[izq.numClaves + j] = der.valores[j];
+        }
+        izq.numClaves += der.numClaves;
+
+        // Sacar la hoja derecha de la lista de hojas
+        izq.siguiente = der.siguiente;
+        if(der.siguiente != -1) nodos[der.siguiente].anterior = indiceIzq;
+        else ultimaHoja = indiceIzq;
+    }
+    else{
+        izq.claves[izq.numClaves] = p.claves[k];  // El separador baja entre ambos
+        for(int j = 0; j < der.numClaves; j++) izq.claves[izq.numClaves + 1 + j] = der.claves[j];
+        for(int j = 0; j <= der.numClaves; j++) izq.valores[izq.numClaves + 1 + j] = der.valores[j];
+        izq.numClaves += 1 + der.numClaves;
+    }
+
+    // Quitar del padre el separador k y el hijo k+1
+    for(int j = k; j < p.numClaves - 1; j++) p.claves[j] = p.claves[j + 1];
+    for(int j = k + 1; j < p.numClaves; j++) p.valores[j] = p.valores[j + 1];
+    p.numClaves--;
+    liberarNodo(indiceDer);
+}
+
+bool ArbolBMas::vecino(int clave, bool haciaArriba, bool incluirIgual, int& resultado){
+    if(raiz == -1) return false;
+    int hoja = descender(clave, nullptr);
+    const NodoBMas& h = nodos[hoja];
+
+    // Primera posicion del lado "mayor": clave >= (techo, predecesor) o > (sucesor, piso)
+    bool mayorOIgual = haciaArriba == incluirIgual;
+    int limite = mayorOIgual ? posicionEnNodo(h, clave) : hijoPara(h, clave);
+
+    if(haciaArriba){
+        if(limite < h.numClaves){
+            resultado = h.claves[limite];
+            return true;
+        }
+        for(int vecina = h.siguiente; vecina != -1; vecina = nodos[vecina].siguiente){
+#ifdef ARBOL_ESTADISTICAS
+            nodosVisitados++;
+#endif
+            if(nodos[vecina].numClaves > 0){      // Primera clave de la hoja siguiente
+                resultado = nodos[vecina].claves[0];
+                return true;
+            }
+        }
+    }
+    else{
+        if(limite > 0){
+            resultado = h.claves[limite - 1];
+            return true;
+        }
+        for(int vecina = h.anterior; vecina != -1; vecina = nodos[vecina].anterior){
+#ifdef ARBOL_ESTADISTICAS
+            nodosVisitados++;
+#endif
+            if(nodos[vecina].numClaves > 0){      // Ultima clave de la hoja anterior
+                resultado = nodos[vecina].claves[nodos[vecina].numClaves - 1];
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+vector<int> ArbolBMas::extremos(int k, bool desdeElMayor){
+    vector<int> resultado;
+    int hoja = desdeElMayor ? ultimaHoja : primeraHoja;
+    while(hoja != -1 && (int)resultado.size() < k){
+#ifdef ARBOL_ESTADISTICAS
+        nodosVisitados++;
+#endif
+        const NodoBMas& h = nodos[hoja];
+        for(int j = 0; j < h.numClaves && (int)resultado.size() < k; j++){
+            resultado.push_back(h.claves[desdeElMayor ? h.numClaves - 1 - j : j]);
+        }
+        hoja = desdeElMayor ? h.anterior : h.siguiente;
+    }
+    return resultado;
+}
+
+vector<pair<int, int>> ArbolBMas::entradas(){
+    vector<pair<int, int>> resultado;
+    resultado.reserve(cantidad);
+    for(int hoja = primeraHoja; hoja != -1; hoja = nodos[hoja].siguiente){
+#ifdef ARBOL_ESTADISTICAS
+        nodosVisitados++;
+#endif
+        const NodoBMas& h = nodos[hoja];
+        for(int j = 0; j < h.numClaves; j++){
+            resultado.push_back({h.claves[j], h.valores[j]});
+        }
+    }
+    return resultado;
+}
+
+void ArbolBMas::vaciar(){
+    nodos.clear();
+    libres.clear();
+    raiz = primeraHoja = ultimaHoja = -1;
+    cantidad = 0;
+}
+
+bool ArbolBMas::construirDesdeOrdenado(const vector<pair<int, int>>& ordenadas){
+    if((int)ordenadas.size() > capacidad) return false;
+    vaciar();
+    if(ordenadas.empty()) return true;
+
+    const int LLENADO = ORDEN_BMAS * 3 / 4;       // Claves por nodo al construir
+    int n = ordenadas.size();
+
+    // PASO 1: Hojas con las entradas repartidas en partes casi iguales
+    int numHojas = (n + LLENADO - 1) / LLENADO;
+    vector<pair<int, int>> nivel;                 // (nodo, clave minima de su subarbol)
+    nivel.reserve(numHojas);
+    int siguienteEntrada = 0;
+    for(int h = 0; h < numHojas; h++){
+        int enHoja = n / numHojas + (h < n % numHojas ? 1 : 0);
+        int hoja = nuevoNodo(true);
+        NodoBMas& nodo = nodos[hoja];
+        for(int j = 0; j < enHoja; j++){
+            nodo.claves[j] = ordenadas[siguienteEntrada].first;
+            nodo.valores[j] = ordenadas[siguienteEntrada].second;
+            siguienteEntrada++;
+        }
+        nodo.numClaves = enHoja;
+        if(!nivel.empty()){
+            nodo.anterior = nivel.back().first;
+            nodos[nivel.back().first].siguiente = hoja;
+        }
+        nivel.push_back({hoja, nodo.claves[0]});
+    }
+    primeraHoja = nivel.front().first;
+    ultimaHoja = nivel.back().first;
+
+    // PASO 2: Niveles internos hasta que quede un solo nodo
+    while(nivel.size() > 1){
+        int hijos = nivel.size();
+        int numNodos = (hijos + LLENADO) / (LLENADO + 1);  // Hasta LLENADO + 1 hijos por nodo
+        if(numNodos < 1) numNodos = 1;
+        vector<pair<int, int>> superior;
+        superior.reserve(numNodos);
+        int siguienteHijo = 0;
+        for(int g = 0; g < numNodos; g++){
+            int enNodo = hijos / numNodos + (g < hijos % numNodos ? 1 : 0);
+            int interno = nuevoNodo(false);
+            NodoBMas& nodo = nodos[interno];
+            for(int j = 0; j < enNodo; j++){
+                nodo.valores[j] = nivel[siguienteHijo].first;
+                if(j > 0) nodo.claves[j - 1] = nivel[siguienteHijo].second;  // Minimo del hijo j
+                siguienteHijo++;
+            }
+            nodo.numClaves = enNodo - 1;
+            superior.push_back({interno, nivel[siguienteHijo - enNodo].second});
+        }
+        nivel.swap(superior);
+    }
+
+    raiz = nivel.front().first;
+    cantidad = n;
+    return true;
+}
+
+int ArbolBMas::numeroEntradas(){
+    return cantidad;
+}
+
+int ArbolBMas::capacidadMaxima(){
+    return capacidad;
+}
+
+bool ArbolBMas::lleno(){
+    return cantidad >= capacidad;
+}
+
+int ArbolBMas::altura(){
+    if(raiz == -1) return 0;
+    int niveles = 1;
+    for(int actual = raiz; !nodos[actual].hoja; actual = nodos[actual].valores[0]){
+        niveles++;                                // Todas las hojas estan al mismo nivel
+    }
+    return niveles;
+}
+
+int ArbolBMas::numeroHojas(){
+    int hojas = 0;
+    for(int hoja = primeraHoja; hoja != -1; hoja = nodos[hoja].siguiente) hojas++;
+    return hojas;
+}
+
+bool ArbolBMas::guardar(const string& archivo){
+    string cuerpo;
+    int claveAnterior = 0, idAnterior = 0;
+    for(int hoja = primeraHoja; hoja != -1; hoja = nodos[hoja].siguiente){
+        const NodoBMas& h = nodos[hoja];
+        for(int j = 0; j < h.numClaves; j++){
+            escribirVarint(cuerpo, aZigZag((int64_t)h.claves[j] - claveAnterior));
+            escribirVarint(cuerpo, aZigZag((int64_t)h.valores[j] - idAnterior));
+            claveAnterior = h.claves[j];
+            idAnterior = h.valores[j];
+        }
+    }
+
+    string contenido = "ABM1";
+    escribirVarint(contenido, capacidad);
+    escribirVarint(contenido, cantidad);
+    contenido.append(cuerpo);
+    uint32_t crc = calcularCrc32(cuerpo);
+    for(int i = 0; i < 4; i++) contenido.push_back((char)(crc >> (8 * i)));
+
+    ofstream salida(archivo, ios::binary);
+    if(!salida.is_open()) return false;
+    salida.write(contenido.data(), contenido.size());
+    return salida.good();
+}
+
+bool ArbolBMas::cargar(const string& archivo){
+    ifstream entrada(archivo, ios::binary);
+    if(!entrada.is_open()) return false;
+    string contenido((istreambuf_iterator<char>(entrada)), istreambuf_iterator<char>());
+    string_view datos(contenido);
+    if(datos.size() < 8 || datos.substr(0, 4) != "ABM1") return false;
+
+    size_t pos = 4;
+    uint64_t capacidadGuardada, numEntradas;
+    if(!leerVarint(datos, pos, capacidadGuardada) || !leerVarint(datos, pos, numEntradas)){
+        return false;
+    }
+    if(numEntradas > (uint64_t)capacidad) return false;   // No cabe en este arbol
+
+    // Verificar la suma antes de reconstruir
+    string_view cuerpo = datos.substr(pos, datos.size() - pos - 4);
+    uint32_t guardado = 0;
+    for(int i = 0; i < 4; i++) guardado |= (uint32_t)(unsigned char)datos[datos.size() - 4 + i] << (8 * i);
+    if(guardado != calcularCrc32(cuerpo)) return false;
+
+    vector<pair<int, int>> ordenadas;
+    ordenadas.reserve(numEntradas);
+    size_t p = 0;
+    int clave = 0, id = 0;
+    for(uint64_t i = 0; i < numEntradas; i++){
+        uint64_t deltaClave, deltaId;
+        if(!leerVarint(cuerpo, p, deltaClave) || !leerVarint(cuerpo, p, deltaId)) return false;
+        clave = (int)(clave + desdeZigZag(deltaClave));
+        id = (int)(id + desdeZigZag(deltaId));
+        ordenadas.push_back({clave, id});
+    }
+    return construirDesdeOrdenado(ordenadas);
+}
+
+#endif //ARBOLBMAS_H
@@ -7,6 +7,18 @@
 #include <queue>
 #include <stack>
 #include <sstream>
+#include <chrono>
+#include <cmath>
+#include <array>
+#include <climits>
+#include <algorithm>
+#include <string_view>
+#include <filesystem>
+
+#include "RegistroEstudiante.h"
+#include "IndicesSecundarios.h"
+#include "CanalizacionLecturas.h"
+#include "ArbolBMas.h"
 
 using namespace std;
 
@@ -31,6 +43,184 @@ struct Nodo{
     Nodo(): clave(0), id_info(-1), izq(-1), der(-1), activo(false) {}
 };
 
+/**
+ * Operaciones del arbol que se cuentan y miden por separado
+ */
+enum OperacionArbol{
+    OP_INSERTAR, OP_BUSCAR, OP_MODIFICAR, OP_ELIMINAR,
+    OP_INORDEN, OP_PREORDEN, OP_POSORDEN, OP_POR_NIVELES,
+    OP_GUARDAR, OP_CARGAR, OP_FUSIONAR, OP_DIVIDIR,
+    OP_VECINO, OP_EXTREMOS,
+    NUM_OPERACIONES
+};
+
+/**
+ * Motor que almacena las claves del arbol (se elige en el constructor)
+ * - MOTOR_BINARIO: arbol binario de busqueda en el arreglo de nodos
+ * - MOTOR_BMAS: arbol B+ con varias claves por nodo y hojas enlazadas (ArbolBMas)
+ */
+enum MotorArbol{
+    MOTOR_BINARIO, MOTOR_BMAS
+};
+
+/**
+ * Histograma de latencias con cubetas de potencias de 2 (en nanosegundos)
+ * La cubeta b cuenta las operaciones que tardaron entre 2^b y 2^(b+1) - 1 ns
+ */
+struct HistogramaLatencia{
+    static const int NUM_CUBETAS = 48;
+    unsigned long long cubetas[NUM_CUBETAS];
+
+    HistogramaLatencia(){
+        for(int b = 0; b < NUM_CUBETAS; b++) cubetas[b] = 0;
+    }
+
+    // Agrega una medicion al histograma
+    void registrar(unsigned long long ns){
+        int b = 0;
+        while((ns >> 1) != 0 && b < NUM_CUBETAS - 1){
+            ns >>= 1;
+            b++;
+        }
+        cubetas[b]++;
+    }
+
+    // Numero total de mediciones registradas
+    unsigned long long total() const{
+        unsigned long long suma = 0;
+        for(int b = 0; b < NUM_CUBETAS; b++) suma += cubetas[b];
+        return suma;
+    }
+
+    // Cota superior (en ns) del percentil p (0-100); 0 si no hay mediciones
+    unsigned long long percentil(double p) const{
+        unsigned long long n = total();
+        if(n == 0) return 0;
+        unsigned long long objetivo = (unsigned long long)(p / 100.0 * n);
+        if(objetivo == 0) objetivo = 1;
+        unsigned long long acumulado = 0;
+        for(int b = 0; b < NUM_CUBETAS; b++){
+            acumulado += cubetas[b];
+            if(acumulado >= objetivo) return (2ULL << b) - 1;
+        }
+        return (2ULL << (NUM_CUBETAS - 1)) - 1;
+    }
+};
+
+/**
+ * Estructura EstadisticasArbol: costo acumulado de las operaciones
+ *
+ * CONTADORES (solo se actualizan si se compila con ARBOL_ESTADISTICAS):
+ * - operaciones: numero de llamadas por tipo de operacion
+ * - comparaciones: comparaciones de claves realizadas (en el motor B+, las
+ *   de la busqueda lineal dentro de cada nodo)
+ * - nodosVisitados: nodos revisados en busquedas y recorridos (en el motor
+ *   B+, un nodo por nivel al descender y cada hoja barrida)
+ * - aperturasArchivo: veces que se abrio un archivo (datos o arbol)
+ * - bytesLeidos / bytesEscritos: trafico con los archivos
+ * - borradosEnArchivo: registros marcados como borrados en el archivo de datos
+ * - rebalanceos: veces que se ejecuto rebalancear (manual o automatico)
+ * - lecturasCanalizadas: lecturas al archivo de la canalizacion (ya agrupadas)
+ * - bytesUtilesCanalizados: bytes de los registros que entrego la canalizacion
+ *   (bytesLeidos incluye ademas los huecos leidos al agrupar)
+ * - latencias: histograma de latencia por tipo de operacion
+ *
+ * ESTRUCTURA (se calcula siempre al pedir las estadisticas):
+ * - altura, profundidadPromedio, nodosActivos
+ * - ranurasUsadas y proporcionRanurasMuertas (ranuras inactivas / usadas)
+ *   En el motor B+: ranuras de clave de las hojas y proporcion sin usar
+ */
+struct EstadisticasArbol{
+    unsigned long long operaciones[NUM_OPERACIONES];
+    unsigned long long comparaciones;
+    unsigned long long nodosVisitados;
+    unsigned long long aperturasArchivo;
+    unsigned long long bytesLeidos;
+    unsigned long long bytesEscritos;
+    unsigned long long borradosEnArchivo;
+    unsigned long long rebalanceos;
+    unsigned long long lecturasCanalizadas;
+    unsigned long long bytesUtilesCanalizados;
+    HistogramaLatencia latencias[NUM_OPERACIONES];
+
+    int altura;
+    double profundidadPromedio;
+    int nodosActivos;
+    int ranurasUsadas;
+    double proporcionRanurasMuertas;
+
+    EstadisticasArbol(): comparaciones(0), nodosVisitados(0), aperturasArchivo(0),
+                         bytesLeidos(0), bytesEscritos(0), borradosEnArchivo(0), rebalanceos(0),
+                         lecturasCanalizadas(0), bytesUtilesCanalizados(0),
+                         altura(0), profundidadPromedio(0.0), nodosActivos(0),
+                         ranurasUsadas(0), proporcionRanurasMuertas(0.0){
+        for(int i = 0; i < NUM_OPERACIONES; i++) operaciones[i] = 0;
+    }
+
+    // Nombre legible de cada operacion (para reportes)
+    static const char* nombreOperacion(int op){
+        static const char* nombres[NUM_OPERACIONES] = {
+            "insertar", "buscar", "modificar", "eliminar",
+            "inorden", "preorden", "posorden", "porNiveles",
+            "guardarArbol", "cargarArbol", "fusionar", "dividir",
+            "vecino", "extremosK"
+        };
+        return nombres[op];
+    }
+
+    // Imprime un resumen legible de las estadisticas
+    void imprimir(ostream& salida) const{
+        salida << "\n=== ESTADISTICAS DEL ARBOL ===" << endl;
+        salida << "Altura: " << altura << "  Profundidad promedio: " << profundidadPromedio
+               << "  Nodos activos: " << nodosActivos << "  Ranuras usadas: " << ranurasUsadas
+               << "  Ranuras muertas: " << proporcionRanurasMuertas * 100.0 << "%" << endl;
+        salida << "Comparaciones: " << comparaciones << "  Nodos visitados: " << nodosVisitados
+               << "  Aperturas de archivo: " << aperturasArchivo << endl;
+        salida << "Bytes leidos: " << bytesLeidos << "  Bytes escritos: " << bytesEscritos
+               << "  Registros borrados: " << borradosEnArchivo
+               << "  Rebalanceos: " << rebalanceos
+               << "  Lecturas canalizadas: " << lecturasCanalizadas
+               << "  Bytes utiles canalizados: " << bytesUtilesCanalizados << endl;
+        for(int op = 0; op < NUM_OPERACIONES; op++){
+            if(operaciones[op] == 0) continue;
+            salida << nombreOperacion(op) << ": " << operaciones[op] << " llamadas, p50 <= "
+                   << latencias[op].percentil(50) << " ns, p99 <= "
+                   << latencias[op].percentil(99) << " ns" << endl;
+        }
+    }
+};
+
+/**
+ * Interruptor de compilacion para la instrumentacion
+ *
+ * Con -DARBOL_ESTADISTICAS las macros actualizan los contadores del arbol;
+ * sin el, se expanden a nada y la instrumentacion no tiene costo.
+ */
+#ifdef ARBOL_ESTADISTICAS
+/**
+ * Mide la latencia de una operacion mientras exista el objeto (RAII)
+ */
+class MedidorLatencia{
+private:
+    EstadisticasArbol& contadores;
+    int operacion;
+    chrono::steady_clock::time_point inicio;
+public:
+    MedidorLatencia(EstadisticasArbol& c, int op): contadores(c), operacion(op), inicio(chrono::steady_clock::now()) {}
+    ~MedidorLatencia(){
+        auto ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - inicio).count();
+        contadores.operaciones[operacion]++;
+        contadores.latencias[operacion].registrar((unsigned long long)ns);
+    }
+};
+
+#define ARBOL_CONTAR(campo, n)  (contadores.campo += (n))
+#define ARBOL_MEDIR(op)         MedidorLatencia medidorOperacion(contadores, op)
+#else
+#define ARBOL_CONTAR(campo, n)  ((void)0)
+#define ARBOL_MEDIR(op)         ((void)0)
+#endif
+
 /**
  * Clase ArbolBinarioOrdenado
  * 
@@ -41,7 +231,10 @@ struct Nodo{
  * - Utiliza arreglo estatico para almacenar nodos
  * - Posicion 0 del arreglo es de control
  * - Persistencia: guarda/carga el arbol en archivo binario
- * - Informacion externa: datos en archivo de texto separado
+ * - Informacion externa: registros en archivo binario separado (ArchivoRegistros)
+ * - Motor alternativo: con MOTOR_BMAS las claves viven en un arbol B+
+ *   (ArbolBMas) con la misma interfaz; archivo de datos, indices
+ *   secundarios, canalizacion y estadisticas son comunes a ambos motores
  */
 class ArbolBinarioOrdenado{
 private:
@@ -51,8 +244,29 @@ private:
     int raiz;               // indice del nodo raiz (-1 si arbol vacio)
     int siguienteLibre;     // Proxima posicion disponible en el arreglo
     string archivoDatos;    // Nombre del archivo que contiene la informacion
+    ArchivoRegistros datos; // Archivo de datos abierto con su indice de IDs
+    IndicesSecundarios indices;  // Indices opcionales por carrera, deporte y edad
+    string archivoIndices;  // Nombre del archivo que guarda los indices secundarios
+    CanalizacionLecturas canalizacion;  // Lectura anticipada de registros (inactiva por defecto)
     string archivoArbol;    // Nombre del archivo que guarda la estructura del arbol
-    
+    MotorArbol motor;       // Motor elegido en el constructor
+    ArbolBMas bmas;         // Claves del motor B+ (vacio con MOTOR_BINARIO)
+    
+    // CONTROL DE BALANCE
+    int nodosActivos;           // Nodos enlazados en el arbol (entradas del motor B+)
+    int profundidadMaxima;      // Cota superior de la altura (se ajusta al insertar y rebalancear)
+    double factorRebalanceo;    // Rebalancear si profundidadMaxima > factor * log2(nodosActivos) (<= 0 desactiva)
+    bool rebalancearAlGuardar;  // Ejecutar rebalancear() antes de guardarArbol()
+    
+    // FORMATO DE PERSISTENCIA
+    bool formatoCompacto;       // Guardar solo nodos vivos con varints (false: arreglo completo)
+    bool sumaVerificacion;      // Agregar CRC-32 por bloque en el formato compacto
+    bool cargaFallida;          // El archivo del arbol existe pero no se pudo cargar:
+                                // el destructor no lo sobrescribe
+#ifdef ARBOL_ESTADISTICAS
+    EstadisticasArbol contadores;   // Costo acumulado de las operaciones
+#endif
+
     // MeTODOS AUXILIARES PRIVADOS
     
     /**
@@ -65,9 +279,10 @@ private:
      * Guarda informacion en el archivo de datos
      * PARaMETROS:
      * - id: Identificador unico del registro
-     * - informacion: Cadena con los datos a guardar
+     * - informacion: Cadena con los datos a guardar (o registro tipado)
      */
-    void guardarEnArchivo(int id, string informacion);
+    void guardarEnArchivo(int id, string_view informacion);
+    void guardarEnArchivo(int id, const Estudiante& estudiante);
     
     /**
      * Lee informacion del archivo usando el ID
@@ -84,6 +299,20 @@ private:
      */
     void marcarBorradoEnArchivo(int id);
     
+    /**
+     * Agrega un registro recien guardado a los indices secundarios habilitados
+     * (el texto sin formato de estudiante no se indexa, ni el estudiante que
+     * no cabe en el formato binario y se guardo como texto libre)
+     */
+    void indexarRegistro(int id, string_view informacion);
+    void indexarRegistro(int id, const Estudiante& estudiante);
+    
+    /**
+     * Quita un registro de los indices secundarios antes de borrarlo
+     * Solo lee el archivo si hay algun indice habilitado
+     */
+    void desindexarRegistro(int id);
+    
     /**
      * Busca la posicion donde deberia insertarse una clave
      * PARaMETROS:
@@ -93,6 +322,117 @@ private:
      */
     int buscarPosicion(int clave, int& padre);
     
+    /**
+     * Busca una clave en el motor activo
+     * RETORNA: id_info de la clave o -1 si no existe
+     */
+    int localizarId(int clave);
+    
+    /**
+     * Clave mas cercana en una direccion (comun a piso, techo, predecesor y sucesor)
+     * PARaMETROS:
+     * - haciaArriba: true busca la menor clave mayor, false la mayor clave menor
+     * - incluirIgual: si la propia clave cuenta como resultado
+     * 
+     * ALGORITMO: descenso BST guardando el mejor candidato visto; cada vez que
+     * un nodo es candidato se sigue hacia el lado que puede acercarse mas
+     */
+    bool buscarVecino(int clave, bool haciaArriba, bool incluirIgual, int& resultado);
+    
+    /**
+     * Las k primeras claves de un inorden (o de un inorden invertido)
+     * Recorrido con pila que se detiene al completar k claves
+     */
+    queue<int> clavesExtremas(int k, bool desdeElMayor);
+    
+    /**
+     * Implementacion comun de insertar para texto y registros tipados
+     */
+    template<typename Registro>
+    bool insertarRegistro(int clave, const Registro& registro);
+    
+    /**
+     * Implementacion comun de modificar para texto y registros tipados
+     */
+    template<typename Registro>
+    bool modificarRegistro(int clave, const Registro& registro);
+    
+    /**
+     * Igual que buscarPosicion, pero tambien cuenta los niveles recorridos
+     * PARaMETROS:
+     * - profundidad: Se llena con el numero de nodos visitados en el camino
+     */
+    int buscarPosicion(int clave, int& padre, int& profundidad);
+    
+    /**
+     * Recorre el arbol por niveles y retorna su altura real
+     * Tambien actualiza nodosActivos con el numero de nodos enlazados
+     */
+    int calcularAltura();
+    
+    /**
+     * Ejecuta rebalancear() si la profundidad maxima registrada supera
+     * factorRebalanceo * log2(nodosActivos)
+     */
+    void verificarBalance();
+    
+    /**
+     * Escritura y lectura de los dos formatos del archivo del arbol
+     * RETORNAN: true si la operacion fue exitosa
+     * 
+     * FORMATO COMPLETO (anterior): tamaño, raiz, siguienteLibre y los
+     * tamaño+1 nodos tal como estan en memoria
+     * 
+     * FORMATO COMPACTO:
+     * - Cabecera: "ABO2", banderas (u8, bit 0 = CRC por bloque),
+     *   tamaño y numero de nodos (varint)
+     * - Nodos vivos en preorden; por nodo dos varints:
+     *   1. ZigZag(clave - clave del padre) << 2 | hijos (bit 0 izq, bit 1 der)
+     *   2. ZigZag(id_info - id_info del nodo anterior)
+     * - Los bytes de nodos se dividen en bloques de hasta 4 KB:
+     *   [longitud varint][bytes][CRC-32 u32 si la bandera esta activa]
+     * - Al cargar, los nodos ocupan las posiciones 1..n (sin ranuras muertas)
+     */
+    bool guardarArbolCompleto();
+    bool guardarArbolCompacto();
+    bool cargarArbolCompleto(ifstream& archivo);
+    bool cargarArbolCompacto(string_view contenido);
+    
+    /**
+     * Entradas (clave, id_info) del motor activo en orden ascendente
+     */
+    vector<pair<int, int>> entradasOrdenadas();
+    
+    /**
+     * Sello con el que se guardan y validan los indices secundarios
+     * Suma de un mezclado de 64 bits de cada par (clave, id_info): no depende
+     * de la forma del arbol ni del motor, y cambia con toda insercion,
+     * eliminacion o modificacion (modificar asigna un id_info nuevo)
+     * COSTO: O(n), igual que guardar o cargar el arbol
+     */
+    uint64_t selloIndices();
+    
+    /**
+     * Reemplaza el contenido del arbol por entradas ordenadas y sin repetidos
+     * Motor binario: las entradas ocupan las posiciones 1..n en orden y el
+     * medio de cada rango es la raiz de su subarbol (arbol completo, sin
+     * ranuras muertas). Motor B+: construccion de abajo hacia arriba
+     * COSTO: O(n + posiciones usadas antes), nunca O(tamaño); no toca el
+     * archivo de datos
+     */
+    void reconstruir(const vector<pair<int, int>>& ordenadas);
+    
+    /**
+     * true si ambos arboles usan el mismo archivo de datos (mismo directorio)
+     */
+    bool compartenDatos(ArbolBinarioOrdenado& otro);
+    
+    /**
+     * Paso de compresion de DSW: aplica 'cantidad' rotaciones a la izquierda
+     * sobre la espina derecha que cuelga de 'raizAuxiliar'
+     */
+    void comprimir(int raizAuxiliar, int cantidad);
+    
     /**
      * Encuentra el nodo con valor minimo en un subarbol
      * PARaMETROS:
@@ -101,6 +441,23 @@ private:
      */
     int encontrarMinimo(int indice);
     
+    /**
+     * Imprime clave e informacion de las entradas (clave, id_info) de la cola, en orden
+     * Si la canalizacion esta activa, los registros se leen por adelantado
+     * en paralelo mientras se imprimen los anteriores
+     */
+    void imprimirEntradas(queue<pair<int, int>>& entradas);
+    
+    /**
+     * Convierte los indices de un recorrido del arreglo en entradas (clave, id_info)
+     */
+    queue<pair<int, int>> entradasDe(queue<int> posiciones);
+    
+    /**
+     * Entradas del motor B+ en orden ascendente (barrido de hojas)
+     */
+    queue<pair<int, int>> entradasBMas();
+    
     /**
      * Implementa el recorrido inorden de forma iterativa
      * RETORNA: Cola con los indices de nodos en orden inorden
@@ -125,6 +482,10 @@ private:
      */
     queue<int> recorridoPorNiveles();
 
+    // La suite de medicion (BenchmarkArbol.cpp) usa los metodos auxiliares
+    // para separar el costo del recorrido del arbol del costo de archivo
+    friend class BenchmarkArbol;
+
 public:
     // MeTODOS PuBLICOS
     
@@ -132,19 +493,25 @@ public:
      * Constructor: Inicializa el arbol con un tamaño especifico
      * PARaMETROS:
      * - n: Numero maximo de elementos que puede contener el arbol
+     * - tipoMotor: MOTOR_BINARIO (por defecto) o MOTOR_BMAS
+     * - directorio: Carpeta de los archivos del arbol (vacio = directorio actual);
+     *   se crea si no existe. Dos arboles abiertos a la vez necesitan carpetas distintas
      * 
      * FUNCIONAMIENTO:
      * 1. Crea arreglo de tamaño n+1 (posicion 0 es de control)
+     *    (con MOTOR_BMAS solo la posicion de control; los nodos son del B+)
      * 2. Inicializa variables de control
      * 3. Carga arbol desde archivo si existe
+     *    (cada motor tiene su archivo: arbol_guardado.dat o arbol_bmas.dat)
      */
-    ArbolBinarioOrdenado(int n);
+    ArbolBinarioOrdenado(int n, MotorArbol tipoMotor = MOTOR_BINARIO, const string& directorio = "");
     
     /**
      * Destructor: Limpia memoria y guarda estado actual
      * 
      * FUNCIONAMIENTO:
-     * 1. Guarda el arbol actual en archivo
+     * 1. Guarda el arbol actual en archivo (salvo que el archivo existente no
+     *    se haya podido cargar y nadie haya llamado a guardarArbol desde entonces)
      * 2. Libera memoria del arreglo
      */
     ~ArbolBinarioOrdenado();
@@ -168,8 +535,18 @@ public:
      * 5. Crear nodo en siguienteLibre
      * 6. Enlazar con padre segun valor de clave
      * 7. Incrementar siguienteLibre
+     * 
+     * NOTA: El texto se recibe como string_view y se codifica directamente
+     * en el archivo, sin copias intermedias. Si tiene el formato
+     * "nombre|carrera|deporte|edad" se guarda como registro tipado
+     */
+    bool insertar(int clave, string_view informacion);
+    
+    /**
+     * Inserta un nuevo nodo con un registro tipado de estudiante
+     * Mismo algoritmo y casos de falla que insertar(clave, informacion)
      */
-    bool insertar(int clave, string informacion);
+    bool insertar(int clave, const Estudiante& estudiante);
     
     /**
      * Busca una clave en el arbol y retorna su informacion
@@ -187,6 +564,63 @@ public:
      */
     string buscar(int clave);
     
+    /**
+     * Busca una clave y lee su registro como estudiante
+     * PARaMETROS:
+     * - clave: Valor a buscar
+     * - salida: Registro a llenar (reutiliza la memoria de sus campos)
+     * RETORNA: true si la clave existe y su registro es un estudiante
+     */
+    bool buscarEstudiante(int clave, Estudiante& salida);
+    
+    /**
+     * Busca una clave y lee un solo campo de su registro
+     * PARaMETROS:
+     * - clave: Valor a buscar
+     * - campo: Campo a leer (nombre, carrera, deporte o edad)
+     * - salida: Se llena con el valor del campo en texto
+     * RETORNA: true si la clave existe y el campo se pudo leer
+     * 
+     * NOTA: Solo se leen del archivo los bytes del campo pedido
+     */
+    bool buscarCampo(int clave, CampoEstudiante campo, string& salida);
+    
+    /**
+     * Busca una clave y lee solo la edad de su registro
+     * RETORNA: Edad o -1 si la clave no existe
+     */
+    int buscarEdad(int clave);
+    
+    /**
+     * Consultas de la clave mas cercana
+     * PARaMETROS:
+     * - clave: Valor de referencia (no necesita existir en el arbol)
+     * - resultado: Se llena con la clave encontrada
+     * RETORNAN: false si no hay ninguna clave en esa direccion
+     * 
+     * - piso: mayor clave <= clave
+     * - techo: menor clave >= clave
+     * - predecesor: mayor clave < clave
+     * - sucesor: menor clave > clave
+     * 
+     * COSTO: O(profundidad): un solo descenso desde la raiz, sin recorridos
+     * NOTA: Solo consultan el arbol; la informacion se obtiene con buscar(resultado)
+     */
+    bool piso(int clave, int& resultado);
+    bool techo(int clave, int& resultado);
+    bool predecesor(int clave, int& resultado);
+    bool sucesor(int clave, int& resultado);
+    
+    /**
+     * Las k claves menores (primerosK, en orden ascendente) o las k mayores
+     * (ultimosK, en orden descendente)
+     * RETORNAN: Cola con hasta k claves (menos si el arbol tiene menos)
+     * 
+     * COSTO: O(profundidad + k): el recorrido se detiene al completar k claves
+     */
+    queue<int> primerosK(int k);
+    queue<int> ultimosK(int k);
+    
     /**
      * Modifica la informacion asociada a una clave
      * PARaMETROS:
@@ -199,7 +633,12 @@ public:
      * 2. Si existe, actualizar informacion en archivo
      * 3. Mantener misma estructura del arbol
      */
-    bool modificar(int clave, string nuevaInformacion);
+    bool modificar(int clave, string_view nuevaInformacion);
+    
+    /**
+     * Reemplaza la informacion asociada a una clave por un registro tipado
+     */
+    bool modificar(int clave, const Estudiante& nuevoEstudiante);
     
     /**
      * Elimina un nodo del arbol
@@ -251,19 +690,25 @@ public:
      * Realiza recorrido por niveles e imprime resultados
      * ORDEN: Nivel por nivel, de izquierda a derecha
      * RESULTADO: Breadth-First Search del arbol
+     * 
+     * NOTA (motor B+): las entradas estan solo en las hojas, todas al mismo
+     * nivel y enlazadas de izquierda a derecha, asi que los cuatro recorridos
+     * entregan las entradas en orden ascendente, igual que inorden
      */
     void porNiveles();
     
     /**
      * Guarda la estructura actual del arbol en archivo binario
      * 
-     * INFORMACIoN GUARDADA:
-     * - Tamaño del arreglo
-     * - indice de la raiz
-     * - Siguiente posicion libre
-     * - Array completo de nodos
+     * INFORMACIoN GUARDADA (formato compacto, por defecto):
+     * - Tamaño del arreglo y numero de nodos
+     * - Solo los nodos vivos, en preorden, con claves e IDs codificados
+     *   como diferencias en varint (los enlaces se reconstruyen al cargar)
      * 
-     * FORMATO: Archivo binario para eficiencia y precision
+     * FORMATO: Archivo binario; ver configurarFormatoArbol
+     * 
+     * NOTA: Si el archivo existente no se pudo cargar, esta llamada explicita
+     * es la que autoriza sobrescribirlo (el destructor no lo hace)
      */
     void guardarArbol();
     
@@ -272,11 +717,179 @@ public:
      * 
      * FUNCIONAMIENTO:
      * 1. Verificar si archivo existe
-     * 2. Leer metadatos (tamaño, raiz, siguienteLibre)
-     * 3. Cargar arreglo completo de nodos
-     * 4. Reconstruir estado exacto anterior
+     * 2. Reconocer el formato (compacto por su firma, o completo)
+     * 3. Compacto: reconstruir enlaces desde el preorden (posiciones 1..n)
+     *    Completo: cargar el arreglo tal cual si el tamaño coincide
+     * 4. Recalcular control de balance y recuperar indices secundarios
+     * 
+     * Si el archivo existe pero esta corrupto o no cabe en este arbol, se
+     * informa por cerr y el archivo queda protegido: ni el destructor ni
+     * dividir lo sobrescriben hasta una llamada explicita a guardarArbol
      */
     void cargarArbol();
+    
+    /**
+     * RETORNA: true si el ultimo intento de carga encontro un archivo del
+     * arbol que no se pudo cargar y todavia no se guardo encima
+     */
+    bool cargaFallo();
+
+    /**
+     * Retorna el costo acumulado de las operaciones y el estado del arbol
+     *
+     * CONTENIDO:
+     * - Contadores y latencias por operacion (en cero si no se compilo
+     *   con ARBOL_ESTADISTICAS)
+     * - Altura, profundidad promedio y proporcion de ranuras muertas
+     *   (calculadas en el momento con un recorrido por niveles)
+     */
+    EstadisticasArbol estadisticas();
+    
+    /**
+     * Rebalancea el arbol en el mismo arreglo con el algoritmo Day-Stout-Warren
+     * 
+     * ALGORITMO:
+     * 1. Usar la posicion 0 (control) como pseudo-raiz temporal
+     * 2. Convertir el arbol en una "espina" con rotaciones a la derecha
+     * 3. Comprimir la espina con rotaciones a la izquierda hasta obtener
+     *    un arbol completo (altura floor(log2(n)) + 1)
+     * 
+     * COSTO: O(n) tiempo, O(1) memoria extra; solo cambian los enlaces izq/der,
+     * las claves e id_info permanecen en sus posiciones del arreglo
+     * 
+     * NOTA: Sin efecto con MOTOR_BMAS (el arbol B+ siempre esta balanceado)
+     */
+    void rebalancear();
+    
+    /**
+     * Configura el rebalanceo automatico
+     * PARaMETROS:
+     * - factor: Rebalancear cuando la profundidad maxima supere
+     *   factor * log2(nodos activos); un valor <= 0 lo desactiva
+     * - antesDeGuardar: Si es true, guardarArbol() rebalancea primero
+     */
+    void configurarRebalanceo(double factor, bool antesDeGuardar);
+    
+    /**
+     * Elige el formato con que guardarArbol escribe el archivo
+     * PARaMETROS:
+     * - compacto: true = solo nodos vivos en preorden con varints (por defecto);
+     *   false = arreglo completo, como en versiones anteriores
+     * - conSumaVerificacion: agrega un CRC-32 por bloque (solo formato compacto)
+     * 
+     * NOTA: cargarArbol reconoce ambos formatos automaticamente.
+     * El motor B+ siempre guarda sus entradas ordenadas con varints y CRC-32
+     */
+    void configurarFormatoArbol(bool compacto, bool conSumaVerificacion);
+    
+    /**
+     * Habilita o deshabilita los indices secundarios
+     * PARaMETROS:
+     * - mascara: Combinacion de INDICE_CARRERA, INDICE_DEPORTE e INDICE_EDAD
+     *   (0 deshabilita todos)
+     * 
+     * FUNCIONAMIENTO:
+     * - Los indices recien habilitados se construyen con un recorrido del arbol
+     * - Desde entonces insertar, modificar y eliminar los mantienen al dia
+     * - guardarArbol los persiste en indices_guardados.dat y el constructor
+     *   los recupera junto con el arbol
+     */
+    void habilitarIndices(int mascara);
+    
+    /**
+     * Consultas por indices secundarios
+     * RETORNAN: id_info de los registros que cumplen, en orden ascendente
+     * (vacio si el indice correspondiente no esta habilitado; consultarEdad
+     * tambien retorna vacio si edadMinima > edadMaxima)
+     * 
+     * NOTA: No leen registros del archivo; para materializarlos usar leerRegistro
+     */
+    vector<int> consultarCarrera(string_view carrera);
+    vector<int> consultarDeporte(string_view deporte);
+    vector<int> consultarEdad(int edadMinima, int edadMaxima);
+    
+    /**
+     * Interseccion de dos resultados de consulta
+     * Ejemplo: intersectar(consultarCarrera("Ingenieria Electronica"), consultarEdad(20, 23))
+     */
+    vector<int> intersectar(const vector<int>& a, const vector<int>& b);
+    
+    /**
+     * Lee el registro de un id_info obtenido en una consulta
+     * RETORNA: true si el registro existe y tiene formato de estudiante
+     */
+    bool leerRegistro(int id_info, Estudiante& salida);
+    
+    /**
+     * Configura la lectura canalizada de registros
+     * PARaMETROS:
+     * - hilos: Hilos lectores (0 la desactiva: lectura secuencial)
+     * - lote: Registros que se piden juntos a un hilo
+     * 
+     * AFECTA: Los cuatro recorridos y buscarVarios
+     */
+    void configurarCanalizacion(int hilos, int lote);
+    
+    /**
+     * Busca varias claves y retorna la informacion de cada una
+     * PARaMETROS:
+     * - claves: Claves a buscar
+     * RETORNA: Informacion en el mismo orden de 'claves'
+     * ("Clave no encontrada" para las que no existen)
+     * 
+     * NOTA: Con la canalizacion activa, las busquedas en el arbol de las
+     * claves siguientes se hacen mientras se leen los registros anteriores
+     */
+    vector<string> buscarVarios(const vector<int>& claves);
+
+    /**
+     * Incorpora todas las claves de otro arbol
+     * PARaMETROS:
+     * - otro: Arbol de origen, abierto en otro directorio (no se modifica)
+     * RETORNA: false si el resultado no cabe en este arbol, si ambos
+     * comparten archivo de datos o si no se pudo copiar un registro
+     * (en todos los casos este arbol queda como estaba)
+     * 
+     * FUNCIONAMIENTO:
+     * 1. Tomar las entradas de ambos arboles en orden (un inorden de cada uno)
+     * 2. Mezclar las dos secuencias; ante una clave repetida se conserva la de este arbol
+     * 3. Copiar al archivo de datos propio los registros que vienen del otro
+     *    arbol con IDs nuevos, para que todo id_info apunte a este archivo;
+     *    si alguna copia falla, se anulan las ya hechas y se retorna false
+     * 4. Reconstruir este arbol, balanceado, con la secuencia mezclada
+     * 
+     * COSTO: O(n + m) en el arbol, mas las ranuras muertas que dejaron
+     * eliminaciones previas (nunca la capacidad completa), en lugar de m
+     * inserciones; los registros incorporados se copian sin decodificarlos
+     */
+    bool fusionar(ArbolBinarioOrdenado& otro);
+    
+    /**
+     * Divide el arbol en una clave
+     * PARaMETROS:
+     * - clave: Las claves >= clave pasan a 'destino'; las menores se quedan
+     * - destino: Arbol vacio abierto en otro directorio
+     * RETORNA: false si destino no esta vacio, no tiene capacidad,
+     * comparte archivo de datos con este arbol, alguno de los dos tiene un
+     * archivo que no se pudo cargar (ver cargaFallo) o no se pudo copiar un registro
+     * 
+     * FUNCIONAMIENTO:
+     * 1. Tomar las entradas en orden y ubicar el corte
+     * 2. Copiar los registros de las claves movidas al archivo de 'destino';
+     *    si alguna copia falla, se anulan las ya hechas y se retorna false
+     *    sin modificar ninguno de los dos arboles
+     * 3. Con todas las copias hechas, marcar los originales como borrados
+     * 4. Reconstruir ambos arboles, balanceados, y guardarlos (cada uno en su
+     *    archivo del arbol)
+     * 
+     * COSTO: O(n) en el arbol, mas las ranuras muertas de este arbol
+     */
+    bool dividir(int clave, ArbolBinarioOrdenado& destino);
+
+    /**
+     * Pone en cero los contadores y los histogramas de latencia
+     */
+    void reiniciarEstadisticas();
 };
 
 // ===============================
@@ -287,22 +900,51 @@ public:
  * CONSTRUCTOR
  * Inicializa todas las estructuras necesarias para el arbol
  */
-ArbolBinarioOrdenado::ArbolBinarioOrdenado(int n){
+ArbolBinarioOrdenado::ArbolBinarioOrdenado(int n, MotorArbol tipoMotor, const string& directorio): bmas(n){
     // Configuracion inicial del arreglo
     tamaño = n;                                    // Tamaño maximo de nodos
-    arreglo = new Nodo[tamaño + 1];               // +1 porque posicion 0 es control
+    motor = tipoMotor;
+    int ranuras = motor == MOTOR_BMAS ? 1 : tamaño + 1;  // El B+ solo usa la posicion de control
+    arreglo = new Nodo[ranuras];                  // +1 porque posicion 0 es control
     raiz = -1;                                    // arbol inicialmente vacio
     siguienteLibre = 1;                           // Primera posicion disponible (0 es control)
     
-    // Configuracion de archivos
-    archivoDatos = "estudiantes.txt";             // Archivo con informacion de nodos
-    archivoArbol = "arbol_guardado.dat";         // Archivo para persistencia del arbol un binario
+    // Control de balance: un arbol aleatorio tiene altura cercana a 3*log2(n),
+    // el factor por defecto solo actua ante arboles claramente degenerados
+    nodosActivos = 0;
+    profundidadMaxima = 0;
+    factorRebalanceo = 4.0;
+    rebalancearAlGuardar = false;
+    
+    // Persistencia compacta con verificacion por defecto
+    formatoCompacto = true;
+    sumaVerificacion = true;
+    cargaFallida = false;
+    
+    // Configuracion de archivos (todos dentro de 'directorio')
+    if(!directorio.empty()){
+        error_code error;
+        filesystem::create_directories(directorio, error);
+    }
+    auto enDirectorio = [&](const char* nombre){
+        return (filesystem::path(directorio) / nombre).string();
+    };
+    archivoDatos = enDirectorio("estudiantes.dat");             // Archivo binario con informacion de nodos
+    archivoArbol = enDirectorio("arbol_guardado.dat");         // Archivo para persistencia del arbol un binario
+    archivoIndices = enDirectorio("indices_guardados.dat");     // Indices secundarios (junto al arbol)
+    if(motor == MOTOR_BMAS){
+        archivoArbol = enDirectorio("arbol_bmas.dat");          // Cada motor guarda su propio arbol
+        archivoIndices = enDirectorio("indices_bmas.dat");
+    }
     
     // Inicializacion del arreglo: todos los nodos en estado por defecto
-    for(int i = 0; i <= tamaño; i++){
+    for(int i = 0; i < ranuras; i++){
         arreglo[i] = Nodo();                      // Constructor por defecto de Nodo
     }
     
+    // Abrir el archivo de datos (importa estudiantes.txt en formato "ID|info" la primera vez)
+    datos.abrir(archivoDatos, enDirectorio("estudiantes.txt"));
+    
     // Intentar cargar arbol previo si existe
     cargarArbol();
 }
@@ -312,15 +954,42 @@ ArbolBinarioOrdenado::ArbolBinarioOrdenado(int n){
  * Limpia memoria y persiste estado actual
  */
 ArbolBinarioOrdenado::~ArbolBinarioOrdenado() {
-    guardarArbol();                               // Guardar estado antes de destruir
+    if(!cargaFallida){
+        guardarArbol();                           // Guardar estado antes de destruir
+    }
     delete[] arreglo;                             // Liberar memoria del arreglo
 }
 
 /**
  * FUNCIoN INSERTAR
+ * Ambas versiones comparten el algoritmo de insertarRegistro
+ */
+bool ArbolBinarioOrdenado::insertar(int clave, string_view informacion){
+    return insertarRegistro(clave, informacion);
+}
+
+bool ArbolBinarioOrdenado::insertar(int clave, const Estudiante& estudiante){
+    return insertarRegistro(clave, estudiante);
+}
+
+/**
  * Algoritmo completo para insertar un nuevo nodo manteniendo orden BST
  */
-bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
+template<typename Registro>
+bool ArbolBinarioOrdenado::insertarRegistro(int clave, const Registro& registro){
+    ARBOL_MEDIR(OP_INSERTAR);
+    
+    if(motor == MOTOR_BMAS){                      // Mismos casos de falla en el arbol B+
+        if(bmas.lleno() || localizarId(clave) != -1){
+            return false;
+        }
+        int id = obtenerIdUnico();
+        guardarEnArchivo(id, registro);
+        indexarRegistro(id, registro);
+        bmas.insertar(clave, id);
+        nodosActivos++;
+        return true;
+    }
     
     // PASO 1: Verificar disponibilidad de espacio
     if(siguienteLibre > tamaño){
@@ -329,7 +998,8 @@ bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
     
     // PASO 2: Buscar posicion donde insertar y obtener padre
     int padre = -1;                               // Almacenara indice del padre
-    int posicion = buscarPosicion(clave, padre);  // Busca donde va y guarda padre
+    int profundidad = 0;                          // Niveles recorridos hasta el padre
+    int posicion = buscarPosicion(clave, padre, profundidad);  // Busca donde va y guarda padre
     
     // PASO 3: Verificar que la clave no exista ya
     if(posicion != -1 && arreglo[posicion].activo){
@@ -338,7 +1008,8 @@ bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
     
     // PASO 4: Preparar informacion externa
     int id = obtenerIdUnico();                    // Generar ID unico para archivo
-    guardarEnArchivo(id, informacion);            // Guardar datos en archivo externo
+    guardarEnArchivo(id, registro);               // Guardar datos en archivo externo
+    indexarRegistro(id, registro);                // Mantener indices secundarios
     
     // PASO 5: Crear el nuevo nodo en siguienteLibre
     arreglo[siguienteLibre].clave = clave;        // Asignar clave
@@ -352,6 +1023,7 @@ bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
         raiz = siguienteLibre;                    // Este nodo se convierte en raiz
     }
     else{                                         // CASO: Enlazar con padre existente
+        ARBOL_CONTAR(comparaciones, 1);
         if(clave < arreglo[padre].clave){         // Determinar si va a izquierda o derecha
             arreglo[padre].izq = siguienteLibre;  // Insertar como hijo izquierdo
         }
@@ -362,6 +1034,13 @@ bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
     
     // PASO 7: Actualizar control de espacio
     siguienteLibre++;                             // Marcar siguiente posicion disponible
+    
+    // PASO 8: Actualizar control de balance (el nuevo nodo queda un nivel bajo el padre)
+    nodosActivos++;
+    if(profundidad + 1 > profundidadMaxima){
+        profundidadMaxima = profundidad + 1;
+    }
+    verificarBalance();
     return true;                                  // Insercion exitosa
 }
 
@@ -370,15 +1049,25 @@ bool ArbolBinarioOrdenado::insertar(int clave, string informacion){
  * Implementa busqueda BST estandar de forma iterativa
  */
 string ArbolBinarioOrdenado::buscar(int clave){
+    ARBOL_MEDIR(OP_BUSCAR);
+    if(motor == MOTOR_BMAS){
+        int id = localizarId(clave);
+        return id != -1 ? leerDelArchivo(id) : "Clave no encontrada";
+    }
+    
     int actual = raiz;                            // Comenzar busqueda desde la raiz
     
     // Recorrer arbol siguiendo propiedades BST
     while(actual != -1 && arreglo[actual].activo){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
         
         if(clave == arreglo[actual].clave){       // CASO: Clave encontrada
             return leerDelArchivo(arreglo[actual].id_info);  // Retornar informacion del archivo
         }
-        else if(clave < arreglo[actual].clave){   // CASO: Buscar en subarbol izquierdo
+        
+        ARBOL_CONTAR(comparaciones, 1);
+        if(clave < arreglo[actual].clave){        // CASO: Buscar en subarbol izquierdo
             actual = arreglo[actual].izq;         // Moverse al hijo izquierdo
         }
         else{                                     // CASO: Buscar en subarbol derecho
@@ -389,11 +1078,46 @@ string ArbolBinarioOrdenado::buscar(int clave){
     return "Clave no encontrada";                 // No se encontro la clave
 }
 
+/**
+ * BuSQUEDAS CON REGISTRO TIPADO
+ * Localizan el nodo y leen del archivo solo lo necesario
+ */
+bool ArbolBinarioOrdenado::buscarEstudiante(int clave, Estudiante& salida){
+    ARBOL_MEDIR(OP_BUSCAR);
+    int id = localizarId(clave);
+    return id != -1 && datos.leerEstudiante(id, salida);
+}
+
+bool ArbolBinarioOrdenado::buscarCampo(int clave, CampoEstudiante campo, string& salida){
+    ARBOL_MEDIR(OP_BUSCAR);
+    int id = localizarId(clave);
+    return id != -1 && datos.leerCampo(id, campo, salida);
+}
+
+int ArbolBinarioOrdenado::buscarEdad(int clave){
+    ARBOL_MEDIR(OP_BUSCAR);
+    int id = localizarId(clave);
+    return id != -1 ? datos.leerEdad(id) : -1;
+}
+
 /**
  * FUNCIoN ELIMINAR
  * Implementa los tres casos de eliminacion en BST
  */
 bool ArbolBinarioOrdenado::eliminar(int clave){
+    ARBOL_MEDIR(OP_ELIMINAR);
+    
+    if(motor == MOTOR_BMAS){                      // El B+ reacomoda sus nodos internamente
+        int id;
+        if(!bmas.eliminar(clave, id)){
+            return false;
+        }
+        cout << "Eliminando: " << leerDelArchivo(id) << endl;
+        desindexarRegistro(id);
+        marcarBorradoEnArchivo(id);
+        nodosActivos--;
+        return true;
+    }
     
     // PASO 1: Buscar nodo a eliminar y su padre
     int padre = -1;                               // indice del padre del nodo a eliminar
@@ -402,11 +1126,15 @@ bool ArbolBinarioOrdenado::eliminar(int clave){
     
     // Busqueda del nodo manteniendo referencia al padre
     while(actual != -1 && arreglo[actual].activo){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
         if(clave == arreglo[actual].clave){
             encontrado = true;                    // Nodo encontrado
             break;                                // Salir del bucle
         }
-        else if(clave < arreglo[actual].clave){
+        
+        ARBOL_CONTAR(comparaciones, 1);
+        if(clave < arreglo[actual].clave){
             padre = actual;                       // Actualizar padre antes de moverse
             actual = arreglo[actual].izq;         // Buscar en izquierda
         }
@@ -424,6 +1152,7 @@ bool ArbolBinarioOrdenado::eliminar(int clave){
     // PASO 3: Imprimir informacion antes de eliminar y marcar en archivo
     string info = leerDelArchivo(arreglo[actual].id_info);
     cout << "Eliminando: " << info << endl;
+    desindexarRegistro(arreglo[actual].id_info);
     marcarBorradoEnArchivo(arreglo[actual].id_info);
     
     // PASO 4: Aplicar algoritmo de eliminacion segun casos
@@ -483,6 +1212,7 @@ bool ArbolBinarioOrdenado::eliminar(int clave){
         
         // Buscar el nodo mas a la izquierda del subarbol derecho
         while(arreglo[sucesor].izq != -1){
+            ARBOL_CONTAR(nodosVisitados, 1);
             sucesorPadre = sucesor;               // Actualizar padre del sucesor
             sucesor = arreglo[sucesor].izq;       // Moverse mas a la izquierda
         }
@@ -502,6 +1232,7 @@ bool ArbolBinarioOrdenado::eliminar(int clave){
         arreglo[sucesor].activo = false;          // Marcar sucesor como eliminado
     }
     
+    nodosActivos--;                               // profundidadMaxima queda como cota superior
     return true;                                  // Eliminacion exitosa
 }
 
@@ -512,66 +1243,34 @@ bool ArbolBinarioOrdenado::eliminar(int clave){
 
 // Recorrido INORDEN iterativo: Izquierda -> Raiz -> Derecha
 void ArbolBinarioOrdenado::inorden(){
+    ARBOL_MEDIR(OP_INORDEN);
     cout << "\n=== RECORRIDO INORDEN ===" << endl;
-    queue<int> resultado = recorridoInorden();    // Obtener cola con recorrido
-    
-    // Imprimir todos los elementos de la cola
-    while(!resultado.empty()){
-        int indice = resultado.front();           // Obtener primer elemento
-        resultado.pop();                          // Remover de cola
-        
-        // Imprimir clave e informacion asociada
-        cout << "Clave: " << arreglo[indice].clave;
-        cout << " -> " << leerDelArchivo(arreglo[indice].id_info) << endl;
-    }
+    queue<pair<int, int>> resultado = motor == MOTOR_BMAS ? entradasBMas() : entradasDe(recorridoInorden());
+    imprimirEntradas(resultado);                  // Imprimir clave e informacion de cada nodo
 }
 
 // Recorrido PREORDEN iterativo: Raiz -> Izquierda -> Derecha  
 void ArbolBinarioOrdenado::preorden(){
+    ARBOL_MEDIR(OP_PREORDEN);
     cout << "\n=== RECORRIDO PREORDEN ===" << endl;
-    queue<int> resultado = recorridoPreorden();   // Obtener cola con recorrido
-    
-    // Imprimir todos los elementos de la cola
-    while(!resultado.empty()){
-        int indice = resultado.front();           // Obtener primer elemento
-        resultado.pop();                          // Remover de cola
-        
-        // Imprimir clave e informacion asociada
-        cout << "Clave: " << arreglo[indice].clave;
-        cout << " -> " << leerDelArchivo(arreglo[indice].id_info) << endl;
-    }
+    queue<pair<int, int>> resultado = motor == MOTOR_BMAS ? entradasBMas() : entradasDe(recorridoPreorden());
+    imprimirEntradas(resultado);                  // Imprimir clave e informacion de cada nodo
 }
 
 // Recorrido POSTORDEN iterativo: Izquierda -> Derecha -> Raiz
 void ArbolBinarioOrdenado::posorden(){
+    ARBOL_MEDIR(OP_POSORDEN);
     cout << "\n=== RECORRIDO POSTORDEN ===" << endl;
-    queue<int> resultado = recorridoPostorden();  // Obtener cola con recorrido
-    
-    // Imprimir todos los elementos de la cola
-    while(!resultado.empty()){
-        int indice = resultado.front();           // Obtener primer elemento
-        resultado.pop();                          // Remover de cola
-        
-        // Imprimir clave e informacion asociada
-        cout << "Clave: " << arreglo[indice].clave;
-        cout << " -> " << leerDelArchivo(arreglo[indice].id_info) << endl;
-    }
+    queue<pair<int, int>> resultado = motor == MOTOR_BMAS ? entradasBMas() : entradasDe(recorridoPostorden());
+    imprimirEntradas(resultado);                  // Imprimir clave e informacion de cada nodo
 }
 
 // Recorrido POR NIVELES iterativo: Breadth-First Search
 void ArbolBinarioOrdenado::porNiveles(){
+    ARBOL_MEDIR(OP_POR_NIVELES);
     cout << "\n=== RECORRIDO POR NIVELES ===" << endl;
-    queue<int> resultado = recorridoPorNiveles(); // Obtener cola con recorrido
-    
-    // Imprimir todos los elementos de la cola
-    while(!resultado.empty()){
-        int indice = resultado.front();           // Obtener primer elemento
-        resultado.pop();                          // Remover de cola
-        
-        // Imprimir clave e informacion asociada
-        cout << "Clave: " << arreglo[indice].clave;
-        cout << " -> " << leerDelArchivo(arreglo[indice].id_info) << endl;
-    }
+    queue<pair<int, int>> resultado = motor == MOTOR_BMAS ? entradasBMas() : entradasDe(recorridoPorNiveles());
+    imprimirEntradas(resultado);                  // Imprimir clave e informacion de cada nodo
 }
 
 // ===============================
@@ -580,71 +1279,74 @@ void ArbolBinarioOrdenado::porNiveles(){
 
 /**
  * Genera ID unico para registros en archivo
- * Implementacion simple: usa timestamp o contador
+ * El archivo de datos entrega IDs mayores a cualquiera ya guardado,
+ * por lo que no se repiten entre ejecuciones
  */
 int ArbolBinarioOrdenado::obtenerIdUnico(){
-    static int contador = 1000;                   // Contador estatico para IDs unicos
-    return contador++;                            // Incrementar y retornar
+    return datos.nuevoId();
 }
 
 /**
  * Guarda informacion en archivo de datos
- * Formato: ID|informacion en nueva linea
+ * Formato: registro binario anexado al final (ver ArchivoRegistros)
  */
-void ArbolBinarioOrdenado::guardarEnArchivo(int id, string informacion){
-    ofstream archivo(archivoDatos, ios::app);     // Abrir en modo append
-    if(archivo.is_open()){
-        archivo << id << "|" << informacion << endl;  // Formato: ID|datos
-        archivo.close();
-    }
+void ArbolBinarioOrdenado::guardarEnArchivo(int id, string_view informacion){
+    datos.guardar(id, informacion);
+}
+
+void ArbolBinarioOrdenado::guardarEnArchivo(int id, const Estudiante& estudiante){
+    datos.guardar(id, estudiante);
 }
 
 /**
  * Lee informacion especifica del archivo usando ID
- * Busca linea que comience con el ID especificado
+ * Lectura posicionada gracias al indice de IDs del archivo
  */
 string ArbolBinarioOrdenado::leerDelArchivo(int id){
-    ifstream archivo(archivoDatos);               // Abrir archivo para lectura
-    string linea;
-    
-    while(getline(archivo, linea)){               // Leer linea por linea
-        if(linea.find(to_string(id) + "|") == 0){ // Verificar si linea comienza con ID|
-            size_t pos = linea.find("|");         // Encontrar separador
-            if(pos != string::npos){
-                return linea.substr(pos + 1);     // Retornar parte despues de |
-            }
-        }
+    string informacion;
+    if(datos.leerTexto(id, informacion)){
+        return informacion;
     }
-    
-    archivo.close();
     return "Informacion no encontrada";           // ID no existe en archivo
 }
 
 /**
  * Marca registro como eliminado en archivo
- * Prefija linea con "ELIMINADO:" para identificar registros borrados
+ * Cambia solo el byte de estado del registro (sin reescribir el archivo)
  */
 void ArbolBinarioOrdenado::marcarBorradoEnArchivo(int id){
-    ifstream archivoLectura(archivoDatos);        // Archivo original
-    ofstream archivoTemp("temp.txt");             // Archivo temporal
-    string linea;
-    
-    // Copiar todas las lineas, modificando la que corresponde al ID
-    while(getline(archivoLectura, linea)){
-        if(linea.find(to_string(id) + "|") == 0){ // Linea del ID a eliminar
-            archivoTemp << "ELIMINADO:" << linea << endl;  // Marcar como eliminado
-        } 
-        else{
-            archivoTemp << linea << endl;          // Copiar linea sin cambios
-        }
+    if(datos.marcarBorrado(id)){
+        ARBOL_CONTAR(borradosEnArchivo, 1);
     }
+}
+
+/**
+ * Mantenimiento de indices secundarios
+ * Se extraen los campos sin copiar el texto (vistas sobre la informacion)
+ */
+void ArbolBinarioOrdenado::indexarRegistro(int id, string_view informacion){
+    if(indices.habilitados() == 0) return;
     
-    archivoLectura.close();
-    archivoTemp.close();
+    string_view partes[3];
+    int edad;
+    if(Estudiante::separar(informacion, partes, edad)){
+        indices.agregar(id, partes[1], partes[2], edad);
+    }
+}
+
+void ArbolBinarioOrdenado::indexarRegistro(int id, const Estudiante& estudiante){
+    // Solo lo que se guardo tipado: desindexarRegistro lo relee con leerEstudiante
+    if(indices.habilitados() == 0 || !estudiante.cabeEnFormatoBinario()) return;
+    indices.agregar(id, estudiante.carrera, estudiante.deporte, estudiante.edad);
+}
+
+void ArbolBinarioOrdenado::desindexarRegistro(int id){
+    if(indices.habilitados() == 0) return;
     
-    // Reemplazar archivo original con el modificado
-    remove(archivoDatos.c_str());                 // Eliminar original
-    rename("temp.txt", archivoDatos.c_str());     // Renombrar temporal
+    Estudiante anterior;
+    if(datos.leerEstudiante(id, anterior)){
+        indices.quitar(id, anterior.carrera, anterior.deporte, anterior.edad);
+    }
 }
 
 /**
@@ -652,6 +1354,12 @@ void ArbolBinarioOrdenado::marcarBorradoEnArchivo(int id){
  * Implementa busqueda BST guardando referencia al padre
  */
 int ArbolBinarioOrdenado::buscarPosicion(int clave, int& padre){
+    int profundidad = 0;
+    return buscarPosicion(clave, padre, profundidad);
+}
+
+int ArbolBinarioOrdenado::buscarPosicion(int clave, int& padre, int& profundidad){
+    profundidad = 0;
     if(raiz == -1) return -1;                     // arbol vacio
     
     int actual = raiz;
@@ -659,11 +1367,15 @@ int ArbolBinarioOrdenado::buscarPosicion(int clave, int& padre){
     
     // Busqueda BST manteniendo referencia al padre
     while(actual != -1){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
+        profundidad++;                            // Un nivel mas en el camino
         if(clave == arreglo[actual].clave){
             return actual;                        // Clave encontrada
         }
         
         padre = actual;                           // Actualizar padre antes de moverse
+        ARBOL_CONTAR(comparaciones, 1);
         if(clave < arreglo[actual].clave){
             actual = arreglo[actual].izq;         // Buscar en izquierda
         } 
@@ -675,6 +1387,34 @@ int ArbolBinarioOrdenado::buscarPosicion(int clave, int& padre){
     return -1;                                    // Clave no encontrada, padre queda configurado
 }
 
+/**
+ * Localiza el id_info de la clave (busqueda BST sin padre, o en el arbol B+)
+ */
+int ArbolBinarioOrdenado::localizarId(int clave){
+    if(motor == MOTOR_BMAS){
+        int id;
+        return bmas.buscar(clave, id) ? id : -1;
+    }
+    
+    int actual = raiz;
+    while(actual != -1 && arreglo[actual].activo){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
+        if(clave == arreglo[actual].clave){
+            return arreglo[actual].id_info;       // Clave encontrada
+        }
+        
+        ARBOL_CONTAR(comparaciones, 1);
+        if(clave < arreglo[actual].clave){
+            actual = arreglo[actual].izq;         // Buscar en izquierda
+        }
+        else{
+            actual = arreglo[actual].der;         // Buscar en derecha
+        }
+    }
+    return -1;                                    // Clave no encontrada
+}
+
 /**
  * Encuentra nodo con valor minimo en subarbol
  * Usado para encontrar sucesor inorden en eliminacion
@@ -686,6 +1426,57 @@ int ArbolBinarioOrdenado::encontrarMinimo(int indice){
     return indice;                                // Retornar indice del minimo
 }
 
+/**
+ * Imprime las entradas de un recorrido
+ * Con canalizacion: el recorrido ya esta calculado, asi que se piden los
+ * registros por adelantado y se imprimen en el mismo orden al llegar
+ */
+void ArbolBinarioOrdenado::imprimirEntradas(queue<pair<int, int>>& entradas){
+    if(!canalizacion.activa()){
+        while(!entradas.empty()){
+            pair<int, int> entrada = entradas.front();  // Obtener primer elemento
+            entradas.pop();                       // Remover de cola
+            cout << "Clave: " << entrada.first;
+            cout << " -> " << leerDelArchivo(entrada.second) << endl;
+        }
+        return;
+    }
+    
+    queue<int> pendientes;                        // Claves ya pedidas, aun sin imprimir
+    canalizacion.procesar(datos, entradas.size(),
+        [&](){
+            pair<int, int> entrada = entradas.front();
+            entradas.pop();
+            pendientes.push(entrada.first);
+            return entrada.second;
+        },
+        [&](optional<string>& informacion){
+            cout << "Clave: " << pendientes.front();
+            cout << " -> " << (informacion ? *informacion : "Informacion no encontrada") << endl;
+            pendientes.pop();
+        });
+}
+
+/**
+ * Entradas (clave, id_info) de los nodos de un recorrido del arreglo
+ */
+queue<pair<int, int>> ArbolBinarioOrdenado::entradasDe(queue<int> posiciones){
+    queue<pair<int, int>> entradas;
+    while(!posiciones.empty()){
+        entradas.push({arreglo[posiciones.front()].clave, arreglo[posiciones.front()].id_info});
+        posiciones.pop();
+    }
+    return entradas;
+}
+
+/**
+ * Entradas del arbol B+ (ya ordenadas por el barrido de hojas)
+ */
+queue<pair<int, int>> ArbolBinarioOrdenado::entradasBMas(){
+    vector<pair<int, int>> ordenadas = bmas.entradas();
+    return queue<pair<int, int>>(deque<pair<int, int>>(ordenadas.begin(), ordenadas.end()));
+}
+
 /**
  * IMPLEMENTACIoN DE RECORRIDOS ITERATIVOS
  * Todos retornan colas con los indices en el orden correspondiente
@@ -708,6 +1499,7 @@ queue<int> ArbolBinarioOrdenado::recorridoInorden(){
         // Procesar nodo en tope de pila
         actual = pila.top();                      // Obtener nodo del tope
         pila.pop();                               // Remover de pila
+        ARBOL_CONTAR(nodosVisitados, 1);
         
         if(arreglo[actual].activo){               // Solo procesar nodos activos
             resultado.push(actual);               // Agregar a resultado
@@ -731,6 +1523,7 @@ queue<int> ArbolBinarioOrdenado::recorridoPreorden(){
     while(!pila.empty()){
         int actual = pila.top();                  // Obtener nodo del tope
         pila.pop();                               // Remover de pila
+        ARBOL_CONTAR(nodosVisitados, 1);
         
         if(arreglo[actual].activo){               // Solo procesar nodos activos
             resultado.push(actual);               // Procesar nodo actual primero
@@ -761,6 +1554,7 @@ queue<int> ArbolBinarioOrdenado::recorridoPostorden(){
         int actual = pila1.top();                 // Obtener nodo de pila1
         pila1.pop();                              // Remover de pila1
         pila2.push(actual);                       // Agregar a pila2
+        ARBOL_CONTAR(nodosVisitados, 1);
         
         // Apilar hijos en pila1 (izquierdo primero)
         if(arreglo[actual].izq != -1){
@@ -795,6 +1589,7 @@ queue<int> ArbolBinarioOrdenado::recorridoPorNiveles(){
     while(!cola.empty()){
         int actual = cola.front();                // Obtener primer elemento
         cola.pop();                               // Remover de cola
+        ARBOL_CONTAR(nodosVisitados, 1);
         
         if(arreglo[actual].activo){               // Solo procesar nodos activos
             resultado.push(actual);               // Agregar a resultado
@@ -816,27 +1611,58 @@ queue<int> ArbolBinarioOrdenado::recorridoPorNiveles(){
  * FUNCIoN MODIFICAR
  * Permite cambiar informacion asociada sin alterar estructura del arbol
  */
-bool ArbolBinarioOrdenado::modificar(int clave, string nuevaInformacion){
+bool ArbolBinarioOrdenado::modificar(int clave, string_view nuevaInformacion){
+    return modificarRegistro(clave, nuevaInformacion);
+}
+
+bool ArbolBinarioOrdenado::modificar(int clave, const Estudiante& nuevoEstudiante){
+    return modificarRegistro(clave, nuevoEstudiante);
+}
+
+template<typename Registro>
+bool ArbolBinarioOrdenado::modificarRegistro(int clave, const Registro& registro){
+    ARBOL_MEDIR(OP_MODIFICAR);
+    
+    if(motor == MOTOR_BMAS){
+        int anterior = localizarId(clave);
+        if(anterior == -1){
+            return false;                         // Clave no encontrada
+        }
+        desindexarRegistro(anterior);
+        marcarBorradoEnArchivo(anterior);
+        
+        int nuevoId = obtenerIdUnico();
+        guardarEnArchivo(nuevoId, registro);
+        indexarRegistro(nuevoId, registro);
+        bmas.reemplazar(clave, nuevoId, anterior);
+        return true;
+    }
     
     // Buscar la clave en el arbol
     int actual = raiz;
     while(actual != -1 && arreglo[actual].activo){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
         if(clave == arreglo[actual].clave){
             // Clave encontrada: actualizar informacion en archivo
             
             // Marcar registro anterior como eliminado
+            desindexarRegistro(arreglo[actual].id_info);
             marcarBorradoEnArchivo(arreglo[actual].id_info);
             
             // Crear nuevo registro con informacion actualizada
             int nuevoId = obtenerIdUnico();
-            guardarEnArchivo(nuevoId, nuevaInformacion);
+            guardarEnArchivo(nuevoId, registro);
+            indexarRegistro(nuevoId, registro);
             
             // Actualizar ID en el nodo
             arreglo[actual].id_info = nuevoId;
             
             return true;                          // Modificacion exitosa
         }
-        else if(clave < arreglo[actual].clave){
+        
+        ARBOL_CONTAR(comparaciones, 1);
+        if(clave < arreglo[actual].clave){
             actual = arreglo[actual].izq;         // Buscar en izquierda
         }
         else{
@@ -852,53 +1678,880 @@ bool ArbolBinarioOrdenado::modificar(int clave, string nuevaInformacion){
  * Persiste todo el estado del arbol para recuperacion posterior
  */
 void ArbolBinarioOrdenado::guardarArbol(){
+    ARBOL_MEDIR(OP_GUARDAR);
+    cargaFallida = false;                         // Guardado explicito: se puede sobrescribir
+    bool guardado;
+    if(motor == MOTOR_BMAS){
+        ARBOL_CONTAR(aperturasArchivo, 1);
+        guardado = bmas.guardar(archivoArbol);    // Entradas ordenadas; se reconstruye al cargar
+    }
+    else{
+        if(rebalancearAlGuardar){
+            rebalancear();                        // Persistir el arbol ya balanceado
+        }
+        guardado = formatoCompacto ? guardarArbolCompacto() : guardarArbolCompleto();
+    }
+    if(guardado){
+        // Indices secundarios junto al arbol (sellados con su contenido)
+        indices.guardar(archivoIndices, selloIndices());
+    }
+}
+
+/**
+ * FORMATO COMPLETO: copia directa del arreglo
+ */
+bool ArbolBinarioOrdenado::guardarArbolCompleto(){
     ofstream archivo(archivoArbol, ios::binary);  // Abrir archivo binario
+    ARBOL_CONTAR(aperturasArchivo, 1);
+    
+    if(!archivo.is_open()) return false;
+    
+    // Guardar metadatos del arbol
+    archivo.write((char*)&tamaño, sizeof(int));           // Tamaño del arreglo
+    archivo.write((char*)&raiz, sizeof(int));             // indice de la raiz
+    archivo.write((char*)&siguienteLibre, sizeof(int));   // Siguiente posicion libre
     
-    if(archivo.is_open()){
-        // Guardar metadatos del arbol
-        archivo.write((char*)&tamaño, sizeof(int));           // Tamaño del arreglo
-        archivo.write((char*)&raiz, sizeof(int));             // indice de la raiz
-        archivo.write((char*)&siguienteLibre, sizeof(int));   // Siguiente posicion libre
+    // Guardar arreglo completo de nodos
+    for(int i = 0; i <= tamaño; i++){
+        archivo.write((char*)&arreglo[i], sizeof(Nodo));   // Escribir cada nodo
+    }
+    ARBOL_CONTAR(bytesEscritos, 3 * sizeof(int) + (tamaño + 1) * sizeof(Nodo));
+    
+    archivo.close();
+    return true;
+}
+
+/**
+ * FORMATO COMPACTO: nodos vivos en preorden, claves e IDs como diferencias
+ */
+bool ArbolBinarioOrdenado::guardarArbolCompacto(){
+    // PASO 1: Codificar los nodos en preorden
+    // En preorden el padre de cada nodo ya fue escrito, asi que al cargar
+    // se conoce su clave y se puede sumar la diferencia
+    string nodos;
+    int numNodos = 0;
+    int idAnterior = 0;
+    stack<pair<int, int>> pila;                   // (indice, clave del padre)
+    if(raiz != -1) pila.push({raiz, 0});
+    
+    while(!pila.empty()){
+        int actual = pila.top().first;
+        int clavePadre = pila.top().second;
+        pila.pop();
+        numNodos++;
         
-        // Guardar arreglo completo de nodos
-        for(int i = 0; i <= tamaño; i++){
-            archivo.write((char*)&arreglo[i], sizeof(Nodo));   // Escribir cada nodo
-        }
+        int hijos = 0;
+        if(arreglo[actual].izq != -1) hijos |= 1;
+        if(arreglo[actual].der != -1) hijos |= 2;
+        
+        escribirVarint(nodos, aZigZag((int64_t)arreglo[actual].clave - clavePadre) << 2 | hijos);
+        escribirVarint(nodos, aZigZag((int64_t)arreglo[actual].id_info - idAnterior));
+        idAnterior = arreglo[actual].id_info;
         
-        archivo.close();
+        // Derecho primero para que el izquierdo se escriba antes
+        if(arreglo[actual].der != -1) pila.push({arreglo[actual].der, arreglo[actual].clave});
+        if(arreglo[actual].izq != -1) pila.push({arreglo[actual].izq, arreglo[actual].clave});
+    }
+    
+    // PASO 2: Cabecera y bloques con suma de verificacion opcional
+    const size_t TAM_BLOQUE = 4096;
+    string contenido = "ABO2";
+    contenido.push_back(sumaVerificacion ? 1 : 0);
+    escribirVarint(contenido, tamaño);
+    escribirVarint(contenido, numNodos);
+    
+    for(size_t inicio = 0; inicio < nodos.size(); inicio += TAM_BLOQUE){
+        string_view bloque = string_view(nodos).substr(inicio, TAM_BLOQUE);
+        escribirVarint(contenido, bloque.size());
+        contenido.append(bloque);
+        if(sumaVerificacion){
+            uint32_t crc = calcularCrc32(bloque);
+            for(int i = 0; i < 4; i++) contenido.push_back((char)(crc >> (8 * i)));
+        }
     }
+    
+    // PASO 3: Una sola escritura
+    ofstream archivo(archivoArbol, ios::binary);
+    ARBOL_CONTAR(aperturasArchivo, 1);
+    if(!archivo.is_open()) return false;
+    archivo.write(contenido.data(), contenido.size());
+    ARBOL_CONTAR(bytesEscritos, contenido.size());
+    return archivo.good();
 }
 
 /**
  * CARGAR aRBOL DESDE ARCHIVO BINARIO  
- * Reconstruye el estado exacto del arbol desde persistencia
+ * Reconoce el formato por su firma y reconstruye el arbol
  */
 void ArbolBinarioOrdenado::cargarArbol(){
+    ARBOL_MEDIR(OP_CARGAR);
+    cargaFallida = false;
+    if(motor == MOTOR_BMAS){
+        ARBOL_CONTAR(aperturasArchivo, 1);
+        error_code error;
+        if(bmas.cargar(archivoArbol)){            // Construccion de abajo hacia arriba
+            nodosActivos = bmas.numeroEntradas();
+            indices.cargar(archivoIndices, selloIndices());
+        }
+        else if(filesystem::exists(archivoArbol, error)){
+            cargaFallida = true;
+            cerr << "No se pudo cargar " << archivoArbol << ": no se sobrescribira sin guardarArbol()" << endl;
+        }
+        return;
+    }
+    
     ifstream archivo(archivoArbol, ios::binary);  // Abrir archivo binario
+    ARBOL_CONTAR(aperturasArchivo, 1);
     
-    if(archivo.is_open()){
-        int tamañoGuardado, raizGuardada, siguienteLibreGuardado;
+    if(!archivo.is_open()){
+        return;                                   // Si archivo no existe, el arbol se mantiene vacio
+    }
+    
+    char firma[4] = {0, 0, 0, 0};
+    archivo.read(firma, 4);
+    bool cargado;
+    if(string_view(firma, 4) == "ABO2"){
+        string contenido((istreambuf_iterator<char>(archivo)), istreambuf_iterator<char>());
+        ARBOL_CONTAR(bytesLeidos, 4 + contenido.size());
+        cargado = cargarArbolCompacto(contenido);
+    }
+    else{
+        archivo.seekg(0);                         // Formato completo: sin firma
+        cargado = cargarArbolCompleto(archivo);
+    }
+    
+    if(cargado){
+        // Reconstruir el control de balance a partir de la forma cargada
+        profundidadMaxima = calcularAltura();
         
-        // Leer metadatos
-        archivo.read((char*)&tamañoGuardado, sizeof(int));
-        archivo.read((char*)&raizGuardada, sizeof(int));
-        archivo.read((char*)&siguienteLibreGuardado, sizeof(int));
+        // Recuperar indices secundarios si corresponden a este arbol
+        indices.cargar(archivoIndices, selloIndices());
+    }
+    else{
+        // Corrupto o de otro tamaño: conservar el archivo para recuperarlo
+        cargaFallida = true;
+        cerr << "No se pudo cargar " << archivoArbol << ": no se sobrescribira sin guardarArbol()" << endl;
+    }
+}
+
+bool ArbolBinarioOrdenado::cargaFallo(){
+    return cargaFallida;
+}
+
+/**
+ * FORMATO COMPLETO: solo se carga si el tamaño coincide
+ */
+bool ArbolBinarioOrdenado::cargarArbolCompleto(ifstream& archivo){
+    int tamañoGuardado, raizGuardada, siguienteLibreGuardado;
+    
+    // Leer metadatos
+    archivo.read((char*)&tamañoGuardado, sizeof(int));
+    archivo.read((char*)&raizGuardada, sizeof(int));
+    archivo.read((char*)&siguienteLibreGuardado, sizeof(int));
+    ARBOL_CONTAR(bytesLeidos, 3 * sizeof(int));
+    
+    // Verificar compatibilidad de tamaño
+    if(!archivo || tamañoGuardado != tamaño){
+        return false;
+    }
+    
+    // Restaurar metadatos
+    raiz = raizGuardada;
+    siguienteLibre = siguienteLibreGuardado;
+    
+    // Cargar arreglo completo
+    for(int i = 0; i <= tamaño; i++){
+        archivo.read((char*)&arreglo[i], sizeof(Nodo));  // Leer cada nodo
+    }
+    ARBOL_CONTAR(bytesLeidos, (tamaño + 1) * sizeof(Nodo));
+    return true;
+}
+
+/**
+ * FORMATO COMPACTO: reconstruye los enlaces con una pila de padres pendientes
+ * Cualquier arbol que quepa en el arreglo se puede cargar
+ */
+bool ArbolBinarioOrdenado::cargarArbolCompacto(string_view contenido){
+    // PASO 1: Cabecera (la firma ya fue leida)
+    size_t pos = 0;
+    uint64_t tamañoGuardado, numNodos;
+    if(contenido.empty()) return false;
+    bool conCrc = contenido[pos++] & 1;
+    if(!leerVarint(contenido, pos, tamañoGuardado) || !leerVarint(contenido, pos, numNodos)){
+        return false;
+    }
+    if(numNodos > (uint64_t)tamaño){
+        return false;                             // No cabe en este arreglo
+    }
+    
+    // PASO 2: Unir los bloques verificando cada suma
+    string nodos;
+    while(pos < contenido.size()){
+        uint64_t longitud;
+        if(!leerVarint(contenido, pos, longitud) || pos + longitud + (conCrc ? 4 : 0) > contenido.size()){
+            return false;
+        }
+        string_view bloque = contenido.substr(pos, longitud);
+        pos += longitud;
+        if(conCrc){
+            uint32_t guardado = 0;
+            for(int i = 0; i < 4; i++) guardado |= (uint32_t)(unsigned char)contenido[pos + i] << (8 * i);
+            pos += 4;
+            if(guardado != calcularCrc32(bloque)){
+                cerr << "Archivo del arbol corrupto: suma de verificacion invalida" << endl;
+                return false;
+            }
+        }
+        nodos.append(bloque);
+    }
+    
+    // PASO 3: Decodificar en un arreglo limpio
+    for(int i = 0; i <= tamaño; i++){
+        arreglo[i] = Nodo();
+    }
+    
+    // Pila de nodos con hijos aun por enlazar: (indice, hijos pendientes)
+    stack<pair<int, int>> pendientes;
+    size_t p = 0;
+    int idAnterior = 0;
+    for(int i = 1; i <= (int)numNodos; i++){
+        uint64_t claveHijos, id;
+        if(!leerVarint(nodos, p, claveHijos) || !leerVarint(nodos, p, id)){
+            raiz = -1;
+            siguienteLibre = 1;
+            return false;
+        }
         
-        // Verificar compatibilidad de tamaño
-        if(tamañoGuardado == tamaño){
-            // Restaurar metadatos
-            raiz = raizGuardada;
-            siguienteLibre = siguienteLibreGuardado;
+        // Enlazar con el padre: hijo izquierdo pendiente primero
+        int clavePadre = 0;
+        if(!pendientes.empty()){
+            pair<int, int>& padre = pendientes.top();
+            clavePadre = arreglo[padre.first].clave;
+            if(padre.second & 1){
+                arreglo[padre.first].izq = i;
+                padre.second &= ~1;
+            }
+            else{
+                arreglo[padre.first].der = i;
+                padre.second &= ~2;
+            }
+            if(padre.second == 0) pendientes.pop();
+        }
+        
+        arreglo[i].clave = (int)(clavePadre + desdeZigZag(claveHijos >> 2));
+        idAnterior = (int)(idAnterior + desdeZigZag(id));
+        arreglo[i].id_info = idAnterior;
+        arreglo[i].activo = true;
+        
+        int hijos = (int)(claveHijos & 3);
+        if(hijos != 0) pendientes.push({i, hijos});
+    }
+    
+    raiz = numNodos > 0 ? 1 : -1;                 // En preorden la raiz es el primero
+    siguienteLibre = (int)numNodos + 1;           // Sin ranuras muertas
+    return true;
+}
+
+/**
+ * CONFIGURAR FORMATO DEL ARCHIVO DEL ARBOL
+ */
+void ArbolBinarioOrdenado::configurarFormatoArbol(bool compacto, bool conSumaVerificacion){
+    formatoCompacto = compacto;
+    sumaVerificacion = conSumaVerificacion;
+}
+
+/**
+ * ESTADiSTICAS
+ * Copia los contadores y calcula la forma actual del arbol con un BFS por niveles
+ */
+EstadisticasArbol ArbolBinarioOrdenado::estadisticas(){
+#ifdef ARBOL_ESTADISTICAS
+    EstadisticasArbol resultado = contadores;     // Contadores acumulados
+    resultado.aperturasArchivo += datos.aperturas;  // Trafico del archivo de datos
+    resultado.bytesLeidos += datos.bytesLeidos;
+    resultado.bytesEscritos += datos.bytesEscritos;
+    resultado.bytesLeidos += canalizacion.bytesLeidos;  // Lecturas de los hilos lectores
+    resultado.lecturasCanalizadas += canalizacion.lecturasFisicas;
+    resultado.bytesUtilesCanalizados += canalizacion.bytesUtiles;
+    resultado.comparaciones += bmas.comparaciones;   // Descensos del motor B+
+    resultado.nodosVisitados += bmas.nodosVisitados;
+#else
+    EstadisticasArbol resultado;                  // Sin instrumentacion: contadores en cero
+#endif
+    
+    if(motor == MOTOR_BMAS){
+        // Todas las entradas estan en las hojas, al mismo nivel
+        resultado.altura = bmas.altura();
+        resultado.nodosActivos = bmas.numeroEntradas();
+        resultado.profundidadPromedio = resultado.nodosActivos > 0 ? resultado.altura : 0.0;
+        resultado.ranurasUsadas = bmas.numeroHojas() * ORDEN_BMAS;
+        if(resultado.ranurasUsadas > 0){
+            resultado.proporcionRanurasMuertas = 1.0 - (double)resultado.nodosActivos / resultado.ranurasUsadas;
+        }
+        return resultado;
+    }
+    
+    // Recorrido por niveles llevando la profundidad de cada nodo
+    long long sumaProfundidades = 0;
+    if(raiz != -1){
+        queue<pair<int, int>> cola;               // (indice, profundidad)
+        cola.push({raiz, 1});
+        while(!cola.empty()){
+            int actual = cola.front().first;
+            int profundidad = cola.front().second;
+            cola.pop();
             
-            // Cargar arreglo completo
-            for(int i = 0; i <= tamaño; i++){
-                archivo.read((char*)&arreglo[i], sizeof(Nodo));  // Leer cada nodo
+            resultado.nodosActivos++;
+            sumaProfundidades += profundidad;
+            if(profundidad > resultado.altura){
+                resultado.altura = profundidad;   // Nivel mas profundo visto
             }
+            
+            if(arreglo[actual].izq != -1) cola.push({arreglo[actual].izq, profundidad + 1});
+            if(arreglo[actual].der != -1) cola.push({arreglo[actual].der, profundidad + 1});
+        }
+    }
+    
+    if(resultado.nodosActivos > 0){
+        resultado.profundidadPromedio = (double)sumaProfundidades / resultado.nodosActivos;
+    }
+    
+    // Ranuras usadas: 1..siguienteLibre-1; las inactivas no se reutilizan
+    resultado.ranurasUsadas = siguienteLibre - 1;
+    if(resultado.ranurasUsadas > 0){
+        int muertas = 0;
+        for(int i = 1; i < siguienteLibre; i++){
+            if(!arreglo[i].activo) muertas++;
+        }
+        resultado.proporcionRanurasMuertas = (double)muertas / resultado.ranurasUsadas;
+    }
+    
+    return resultado;
+}
+
+/**
+ * REINICIAR ESTADiSTICAS
+ * Descarta los contadores acumulados hasta el momento
+ */
+void ArbolBinarioOrdenado::reiniciarEstadisticas(){
+#ifdef ARBOL_ESTADISTICAS
+    contadores = EstadisticasArbol();
+    datos.aperturas = 0;
+    datos.bytesLeidos = 0;
+    datos.bytesEscritos = 0;
+    canalizacion.bytesLeidos = 0;
+    canalizacion.lecturasFisicas = 0;
+    canalizacion.bytesUtiles = 0;
+    bmas.comparaciones = 0;
+    bmas.nodosVisitados = 0;
+#endif
+}
+
+/**
+ * CALCULAR ALTURA
+ * Recorrido por niveles contando niveles completos de la cola
+ */
+int ArbolBinarioOrdenado::calcularAltura(){
+    nodosActivos = 0;
+    if(raiz == -1) return 0;
+    
+    int altura = 0;
+    queue<int> cola;
+    cola.push(raiz);
+    while(!cola.empty()){
+        int enNivel = cola.size();                // Nodos del nivel actual
+        altura++;
+        for(int i = 0; i < enNivel; i++){
+            int actual = cola.front();
+            cola.pop();
+            nodosActivos++;
+            if(arreglo[actual].izq != -1) cola.push(arreglo[actual].izq);
+            if(arreglo[actual].der != -1) cola.push(arreglo[actual].der);
         }
+    }
+    return altura;
+}
+
+/**
+ * VERIFICAR BALANCE
+ * Dispara el rebalanceo automatico si el arbol se degenero
+ */
+void ArbolBinarioOrdenado::verificarBalance(){
+    if(factorRebalanceo <= 0 || nodosActivos < 2) return;
+    
+    if(profundidadMaxima > factorRebalanceo * log2((double)nodosActivos)){
+        rebalancear();
+    }
+}
+
+/**
+ * REBALANCEAR (Day-Stout-Warren)
+ * Fase 1: arbol -> espina; Fase 2: espina -> arbol completo
+ */
+void ArbolBinarioOrdenado::rebalancear(){
+    if(raiz == -1) return;                        // Nada que balancear
+    ARBOL_CONTAR(rebalanceos, 1);
+    
+    // La posicion 0 (control) sirve de pseudo-raiz: su hijo derecho es la raiz
+    Nodo control = arreglo[0];                    // Respaldar posicion de control
+    arreglo[0].izq = -1;
+    arreglo[0].der = raiz;
+    
+    // FASE 1: Convertir en espina derecha con rotaciones a la derecha
+    int cola = 0;                                 // Ultimo nodo ya ubicado en la espina
+    int resto = arreglo[0].der;                   // Parte del arbol aun por procesar
+    int n = 0;                                    // Nodos en la espina
+    while(resto != -1){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        if(arreglo[resto].izq == -1){             // Sin hijo izquierdo: avanzar
+            cola = resto;
+            resto = arreglo[resto].der;
+            n++;
+        }
+        else{                                     // Rotar a la derecha sobre 'resto'
+            int temp = arreglo[resto].izq;
+            arreglo[resto].izq = arreglo[temp].der;
+            arreglo[temp].der = resto;
+            resto = temp;
+            arreglo[cola].der = temp;
+        }
+    }
+    
+    // FASE 2: Comprimir la espina
+    // Primero se ubican las hojas sobrantes del ultimo nivel incompleto
+    int completo = 1;
+    while(completo * 2 <= n + 1){
+        completo *= 2;                            // Mayor potencia de 2 <= n + 1
+    }
+    int hojas = n + 1 - completo;
+    comprimir(0, hojas);
+    
+    // Luego se compacta la espina restante por mitades
+    int restantes = n - hojas;
+    while(restantes > 1){
+        restantes /= 2;
+        comprimir(0, restantes);
+    }
+    
+    // Restaurar la posicion de control y actualizar la raiz
+    raiz = arreglo[0].der;
+    arreglo[0] = control;
+    
+    nodosActivos = n;
+    profundidadMaxima = (int)log2((double)n) + 1; // Arbol completo
+}
+
+/**
+ * COMPRIMIR
+ * Cada rotacion a la izquierda baja un nodo de la espina como hijo izquierdo
+ */
+void ArbolBinarioOrdenado::comprimir(int raizAuxiliar, int cantidad){
+    int explorador = raizAuxiliar;
+    for(int i = 0; i < cantidad; i++){
+        int hijo = arreglo[explorador].der;
+        arreglo[explorador].der = arreglo[hijo].der;
+        explorador = arreglo[explorador].der;
+        arreglo[hijo].der = arreglo[explorador].izq;
+        arreglo[explorador].izq = hijo;
+    }
+}
+
+/**
+ * CONFIGURAR REBALANCEO
+ */
+void ArbolBinarioOrdenado::configurarRebalanceo(double factor, bool antesDeGuardar){
+    factorRebalanceo = factor;
+    rebalancearAlGuardar = antesDeGuardar;
+    verificarBalance();                           // Aplicar el nuevo umbral de inmediato
+}
+
+/**
+ * HABILITAR INDICES SECUNDARIOS
+ * Construye los indices nuevos leyendo una vez cada registro del arbol
+ */
+void ArbolBinarioOrdenado::habilitarIndices(int mascara){
+    int porLlenar = indices.habilitar(mascara);
+    if(porLlenar == 0) return;                    // Nada nuevo que construir
+    
+    queue<pair<int, int>> entradas = motor == MOTOR_BMAS ? entradasBMas() : entradasDe(recorridoInorden());
+    Estudiante estudiante;                        // Reutilizado en cada lectura
+    while(!entradas.empty()){
+        int id = entradas.front().second;
+        entradas.pop();
+        if(datos.leerEstudiante(id, estudiante)){
+            indices.agregar(id, estudiante.carrera, estudiante.deporte, estudiante.edad, porLlenar);
+        }
+    }
+}
+
+/**
+ * CONSULTAS POR INDICES SECUNDARIOS
+ */
+vector<int> ArbolBinarioOrdenado::consultarCarrera(string_view carrera){
+    return indices.consultarCarrera(carrera);
+}
+
+vector<int> ArbolBinarioOrdenado::consultarDeporte(string_view deporte){
+    return indices.consultarDeporte(deporte);
+}
+
+vector<int> ArbolBinarioOrdenado::consultarEdad(int edadMinima, int edadMaxima){
+    return indices.consultarEdad(edadMinima, edadMaxima);
+}
+
+vector<int> ArbolBinarioOrdenado::intersectar(const vector<int>& a, const vector<int>& b){
+    return IndicesSecundarios::intersectar(a, b);
+}
+
+bool ArbolBinarioOrdenado::leerRegistro(int id_info, Estudiante& salida){
+    return datos.leerEstudiante(id_info, salida);
+}
+
+/**
+ * CONFIGURAR CANALIZACIoN
+ */
+void ArbolBinarioOrdenado::configurarCanalizacion(int hilos, int lote){
+    if(hilos <= 0){
+        canalizacion.detener();                   // Volver a lectura secuencial
+        return;
+    }
+    canalizacion.iniciar(datos.nombreArchivo(), hilos, lote);
+}
+
+/**
+ * BUSCAR VARIAS CLAVES
+ * La busqueda en el arbol de cada clave se hace cuando la canalizacion pide
+ * el siguiente ID, intercalada con las lecturas en curso
+ */
+vector<string> ArbolBinarioOrdenado::buscarVarios(const vector<int>& claves){
+    vector<string> resultados;
+    resultados.reserve(claves.size());
+    
+    if(!canalizacion.activa()){
+        for(int clave : claves){
+            resultados.push_back(buscar(clave));
+        }
+        return resultados;
+    }
+    
+    size_t siguiente = 0;                         // Proxima clave a buscar en el arbol
+    vector<bool> encontrada(claves.size());
+    canalizacion.procesar(datos, claves.size(),
+        [&](){
+            int id = localizarId(claves[siguiente]);
+            encontrada[siguiente++] = id != -1;
+            return id;
+        },
+        [&](optional<string>& informacion){
+            if(!encontrada[resultados.size()]){
+                resultados.push_back("Clave no encontrada");
+            }
+            else{
+                resultados.push_back(informacion ? move(*informacion) : "Informacion no encontrada");
+            }
+        });
+    return resultados;
+}
+
+/**
+ * ENTRADAS ORDENADAS
+ * Inorden del arreglo o barrido de hojas del B+
+ */
+vector<pair<int, int>> ArbolBinarioOrdenado::entradasOrdenadas(){
+    if(motor == MOTOR_BMAS){
+        return bmas.entradas();
+    }
+    
+    vector<pair<int, int>> resultado;
+    resultado.reserve(nodosActivos);
+    queue<int> nodos = recorridoInorden();
+    while(!nodos.empty()){
+        resultado.push_back({arreglo[nodos.front()].clave, arreglo[nodos.front()].id_info});
+        nodos.pop();
+    }
+    return resultado;
+}
+
+/**
+ * SELLO DE LOS INDICES
+ * Suma conmutativa: el resultado no depende del orden del recorrido
+ */
+uint64_t ArbolBinarioOrdenado::selloIndices(){
+    uint64_t sello = 0;
+    for(const pair<int, int>& entrada : entradasOrdenadas()){
+        uint64_t x = ((uint64_t)(uint32_t)entrada.first << 32) | (uint32_t)entrada.second;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;  // Mezclador de splitmix64
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        sello += x ^ (x >> 31);
+    }
+    return sello;
+}
+
+/**
+ * RECONSTRUIR
+ * Arbol completo a partir de una secuencia ordenada
+ */
+void ArbolBinarioOrdenado::reconstruir(const vector<pair<int, int>>& ordenadas){
+    int n = ordenadas.size();
+    nodosActivos = n;
+    if(motor == MOTOR_BMAS){
+        bmas.construirDesdeOrdenado(ordenadas);
+        return;
+    }
+    
+    // PASO 1: Entradas en las posiciones 1..n, en orden
+    // Solo se limpian las posiciones que se usaron: desde siguienteLibre
+    // en adelante el arreglo ya esta en su estado inicial
+    int usadas = max(siguienteLibre - 1, n);
+    for(int i = 0; i <= usadas; i++){
+        arreglo[i] = Nodo();
+    }
+    for(int i = 0; i < n; i++){
+        arreglo[i + 1].clave = ordenadas[i].first;
+        arreglo[i + 1].id_info = ordenadas[i].second;
+        arreglo[i + 1].activo = true;
+    }
+    
+    // PASO 2: Enlazar: el medio de cada rango cuelga del medio del rango que lo contiene
+    raiz = -1;
+    stack<array<int, 3>> rangos;                  // (inicio, fin, padre)
+    if(n > 0) rangos.push({1, n, -1});
+    while(!rangos.empty()){
+        int inicio = rangos.top()[0], fin = rangos.top()[1], padre = rangos.top()[2];
+        rangos.pop();
+        int medio = (inicio + fin) / 2;
+        
+        if(padre == -1)          raiz = medio;
+        else if(medio < padre)   arreglo[padre].izq = medio;
+        else                     arreglo[padre].der = medio;
         
-        archivo.close();
+        if(inicio < medio) rangos.push({inicio, medio - 1, medio});
+        if(medio < fin)    rangos.push({medio + 1, fin, medio});
+    }
+    
+    siguienteLibre = n + 1;                       // Sin ranuras muertas
+    profundidadMaxima = n > 0 ? (int)log2((double)n) + 1 : 0;
+}
+
+bool ArbolBinarioOrdenado::compartenDatos(ArbolBinarioOrdenado& otro){
+    error_code error;
+    return &otro == this || filesystem::equivalent(datos.nombreArchivo(), otro.datos.nombreArchivo(), error);
+}
+
+/**
+ * FUSIONAR
+ * Mezcla de dos inorden y reconstruccion balanceada
+ */
+bool ArbolBinarioOrdenado::fusionar(ArbolBinarioOrdenado& otro){
+    ARBOL_MEDIR(OP_FUSIONAR);
+    if(compartenDatos(otro)){
+        return false;                             // Los IDs de ambos se confundirian
+    }
+    
+    // PASO 1: Mezclar las dos secuencias ordenadas
+    vector<pair<int, int>> propias = entradasOrdenadas();
+    vector<pair<int, int>> ajenas = otro.entradasOrdenadas();
+    
+    vector<pair<int, int>> mezcla;
+    vector<size_t> copiar;                        // Posiciones de la mezcla que vienen del otro arbol
+    mezcla.reserve(propias.size() + ajenas.size());
+    size_t i = 0, j = 0;
+    while(i < propias.size() || j < ajenas.size()){
+        ARBOL_CONTAR(comparaciones, 1);
+        if(j == ajenas.size() || (i < propias.size() && propias[i].first <= ajenas[j].first)){
+            if(j < ajenas.size() && propias[i].first == ajenas[j].first){
+                j++;                              // Clave repetida: se conserva la propia
+            }
+            mezcla.push_back(propias[i++]);
+        }
+        else{
+            copiar.push_back(mezcla.size());
+            mezcla.push_back(ajenas[j++]);
+        }
+    }
+    
+    if((int)mezcla.size() > tamaño){
+        return false;                             // No cabe: el arbol queda como estaba
+    }
+    
+    // PASO 2: Traer los registros del otro arbol con IDs de este archivo
+    // Si una copia falla se anulan las ya hechas y el arbol queda como estaba
+    vector<int> nuevosIds;
+    nuevosIds.reserve(copiar.size());
+    for(size_t posicion : copiar){
+        int nuevoId = obtenerIdUnico();
+        if(!datos.copiarDe(otro.datos, mezcla[posicion].second, nuevoId)){
+            for(int copiado : nuevosIds){
+                datos.marcarBorrado(copiado);
+            }
+            return false;
+        }
+        nuevosIds.push_back(nuevoId);
+    }
+    
+    // PASO 3: Indexar los registros copiados
+    Estudiante estudiante;
+    for(size_t k = 0; k < copiar.size(); k++){
+        if(indices.habilitados() != 0 && datos.leerEstudiante(nuevosIds[k], estudiante)){
+            indexarRegistro(nuevosIds[k], estudiante);
+        }
+        mezcla[copiar[k]].second = nuevosIds[k];
+    }
+    
+    // PASO 4: Arbol balanceado con todas las claves
+    reconstruir(mezcla);
+    return true;
+}
+
+/**
+ * DIVIDIR
+ * Corte de la secuencia inorden y reconstruccion de ambos arboles
+ */
+bool ArbolBinarioOrdenado::dividir(int clave, ArbolBinarioOrdenado& destino){
+    ARBOL_MEDIR(OP_DIVIDIR);
+    if(compartenDatos(destino) || destino.nodosActivos != 0){
+        return false;
+    }
+    if(cargaFallida || destino.cargaFallida){
+        return false;                             // Guardar ambos pisaria un archivo sin cargar
+    }
+    
+    // PASO 1: Ubicar el corte en la secuencia ordenada
+    vector<pair<int, int>> entradas = entradasOrdenadas();
+    size_t corte = lower_bound(entradas.begin(), entradas.end(), make_pair(clave, INT_MIN)) - entradas.begin();
+    if((int)(entradas.size() - corte) > destino.tamaño){
+        return false;                             // No cabe en el destino
+    }
+    vector<pair<int, int>> movidas(entradas.begin() + corte, entradas.end());
+    entradas.resize(corte);
+    
+    // PASO 2: Copiar los registros al archivo del destino
+    // Nada se borra del origen hasta que todas las copias salieron bien
+    vector<int> nuevosIds;
+    nuevosIds.reserve(movidas.size());
+    for(const pair<int, int>& entrada : movidas){
+        int nuevoId = destino.obtenerIdUnico();
+        if(!destino.datos.copiarDe(datos, entrada.second, nuevoId)){
+            for(int copiado : nuevosIds){
+                destino.datos.marcarBorrado(copiado);  // Deshacer las copias ya hechas
+            }
+            return false;                         // Ambos arboles quedan como estaban
+        }
+        nuevosIds.push_back(nuevoId);
+    }
+    
+    // PASO 3: Indexar en el destino y retirar los registros del origen
+    Estudiante estudiante;
+    for(size_t i = 0; i < movidas.size(); i++){
+        if(destino.indices.habilitados() != 0 && destino.datos.leerEstudiante(nuevosIds[i], estudiante)){
+            destino.indexarRegistro(nuevosIds[i], estudiante);
+        }
+        desindexarRegistro(movidas[i].second);
+        marcarBorradoEnArchivo(movidas[i].second);
+        movidas[i].second = nuevosIds[i];
+    }
+    
+    // PASO 4: Reconstruir y persistir ambos arboles
+    reconstruir(entradas);
+    destino.reconstruir(movidas);
+    guardarArbol();
+    destino.guardarArbol();
+    return true;
+}
+
+/**
+ * CONSULTAS DE CLAVE MAS CERCANA
+ * Las cuatro comparten el mismo descenso
+ */
+bool ArbolBinarioOrdenado::piso(int clave, int& resultado){
+    return buscarVecino(clave, false, true, resultado);
+}
+
+bool ArbolBinarioOrdenado::techo(int clave, int& resultado){
+    return buscarVecino(clave, true, true, resultado);
+}
+
+bool ArbolBinarioOrdenado::predecesor(int clave, int& resultado){
+    return buscarVecino(clave, false, false, resultado);
+}
+
+bool ArbolBinarioOrdenado::sucesor(int clave, int& resultado){
+    return buscarVecino(clave, true, false, resultado);
+}
+
+bool ArbolBinarioOrdenado::buscarVecino(int clave, bool haciaArriba, bool incluirIgual, int& resultado){
+    ARBOL_MEDIR(OP_VECINO);
+    if(motor == MOTOR_BMAS){
+        return bmas.vecino(clave, haciaArriba, incluirIgual, resultado);
+    }
+    
+    bool encontrado = false;
+    int actual = raiz;
+    while(actual != -1 && arreglo[actual].activo){
+        ARBOL_CONTAR(nodosVisitados, 1);
+        ARBOL_CONTAR(comparaciones, 1);
+        int valor = arreglo[actual].clave;
+        if(valor == clave && incluirIgual){
+            resultado = valor;                    // Coincidencia exacta: no hay nada mas cerca
+            return true;
+        }
+        
+        bool candidato = haciaArriba ? valor > clave : valor < clave;
+        if(candidato){
+            resultado = valor;                    // Mejor candidato hasta ahora
+            encontrado = true;
+        }
+        
+        // Un candidato se mejora acercandose a 'clave'; un no candidato, alejandose
+        if(candidato == haciaArriba){
+            actual = arreglo[actual].izq;         // Buscar en izquierda
+        }
+        else{
+            actual = arreglo[actual].der;         // Buscar en derecha
+        }
+    }
+    return encontrado;
+}
+
+/**
+ * PRIMEROS Y ULTIMOS K
+ */
+queue<int> ArbolBinarioOrdenado::primerosK(int k){
+    return clavesExtremas(k, false);
+}
+
+queue<int> ArbolBinarioOrdenado::ultimosK(int k){
+    return clavesExtremas(k, true);
+}
+
+queue<int> ArbolBinarioOrdenado::clavesExtremas(int k, bool desdeElMayor){
+    ARBOL_MEDIR(OP_EXTREMOS);
+    queue<int> resultado;
+    if(motor == MOTOR_BMAS){
+        for(int clave : bmas.extremos(k, desdeElMayor)){
+            resultado.push(clave);
+        }
+        return resultado;
+    }
+    
+    // Inorden iterativo (invertido si se piden las mayores) que se detiene en k
+    stack<int> pila;
+    int actual = raiz;
+    while((actual != -1 || !pila.empty()) && (int)resultado.size() < k){
+        while(actual != -1){
+            pila.push(actual);                    // Bajar por el extremo
+            actual = desdeElMayor ? arreglo[actual].der : arreglo[actual].izq;
+        }
+        
+        actual = pila.top();
+        pila.pop();
+        ARBOL_CONTAR(nodosVisitados, 1);
+        if(arreglo[actual].activo){
+            resultado.push(arreglo[actual].clave);
+        }
+        actual = desdeElMayor ? arreglo[actual].izq : arreglo[actual].der;
     }
-    // Si archivo no existe, el arbol se mantiene vacio (inicializacion por defecto)
+    return resultado;
 }
 
 #endif //ARBOLBINORDENADO_H
\ No newline at end of file
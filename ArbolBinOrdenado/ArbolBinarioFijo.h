@@ -0,0 +1,261 @@
+#ifndef ARBOLBINARIOFIJO_H
+#define ARBOLBINARIOFIJO_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * Tipo de indice mas angosto que representa las posiciones 0..N
+ */
+template<size_t N>
+using IndiceMinimo = conditional_t<N <= UINT8_MAX, uint8_t,
+                     conditional_t<N <= UINT16_MAX, uint16_t, uint32_t>>;
+
+/**
+ * Clase ArbolBinarioFijo
+ *
+ * Arbol binario ordenado con capacidad N fija en compilacion, para arboles
+ * pequeños (por sesion) que no deben tocar el heap.
+ *
+ * CARACTERiSTICAS:
+ * - Los nodos viven dentro del objeto (std::array), sin new/delete
+ * - Indices de hijos del tipo mas angosto posible: uint8_t hasta N = 255,
+ *   uint16_t hasta 65535, uint32_t en adelante
+ * - Un arreglo por campo (claves, ids, izq, der): la busqueda solo recorre
+ *   los arreglos de claves e hijos
+ * - Posicion 0 de control: izq[0] es la raiz y der[0] la primera posicion
+ *   liberada; el indice 0 significa "sin nodo"
+ * - Las posiciones de nodos eliminados se reutilizan (lista de libres)
+ * - Todas las operaciones son constexpr: un arbol se puede construir y
+ *   consultar en tiempo de compilacion
+ *
+ * MEMORIA POR NODO: clave + id_info (8 bytes) + dos indices: 10 bytes con
+ * uint8_t, 12 con uint16_t y 16 con uint32_t (Nodo ocupa 20)
+ *
+ * ALCANCE: solo el indice clave -> id_info. La informacion de cada clave se
+ * guarda aparte, como hace ArbolBinarioOrdenado con su archivo de datos
+ *
+ * EJEMPLO:
+ *   constexpr auto tabla = []{
+ *       ArbolBinarioFijo<8> arbol;
+ *       arbol.insertar(20, 1000);
+ *       arbol.insertar(10, 1001);
+ *       return arbol;
+ *   }();
+ *   static_assert(tabla.buscar(10) == 1001);
+ */
+template<size_t N>
+class ArbolBinarioFijo{
+    static_assert(N >= 1 && N < UINT32_MAX, "Capacidad fuera de rango");
+
+public:
+    using Indice = IndiceMinimo<N>;
+
+private:
+    array<int, N + 1> claves;       // Clave de cada posicion
+    array<int, N + 1> ids;          // id_info de cada posicion
+    array<Indice, N + 1> izq;       // Hijo izquierdo (izq[0] = raiz)
+    array<Indice, N + 1> der;       // Hijo derecho (der[0] = primera posicion libre)
+    size_t siguienteLibre;          // Proxima posicion nunca usada
+    size_t numNodos;                // Nodos enlazados en el arbol
+
+    /**
+     * Busca una clave guardando el padre del ultimo nodo visitado
+     * RETORNA: Posicion de la clave o 0 si no existe (padre queda donde iria)
+     */
+    constexpr Indice ubicar(int clave, Indice& padre) const{
+        padre = 0;
+        Indice actual = izq[0];
+        while(actual != 0 && claves[actual] != clave){
+            padre = actual;
+            actual = clave < claves[actual] ? izq[actual] : der[actual];
+        }
+        return actual;
+    }
+
+public:
+    /**
+     * Constructor: arbol vacio (constexpr)
+     */
+    constexpr ArbolBinarioFijo(): claves{}, ids{}, izq{}, der{}, siguienteLibre(1), numNodos(0) {}
+
+    /**
+     * Inserta una clave con su id_info
+     * RETORNA: false si el arbol esta lleno o la clave ya existe
+     */
+    constexpr bool insertar(int clave, int id_info){
+        Indice padre = 0;
+        if(ubicar(clave, padre) != 0){
+            return false;                         // Clave duplicada
+        }
+
+        // Reutilizar una posicion liberada o tomar la siguiente nunca usada
+        Indice nuevo = 0;
+        if(der[0] != 0){
+            nuevo = der[0];
+            der[0] = izq[nuevo];
+        }
+        else if(siguienteLibre <= N){
+            nuevo = (Indice)siguienteLibre++;
+        }
+        else{
+            return false;                         // Arbol lleno
+        }
+
+        claves[nuevo] = clave;
+        ids[nuevo] = id_info;
+        izq[nuevo] = 0;
+        der[nuevo] = 0;
+
+        // La posicion 0 actua como padre de la raiz
+        if(padre == 0 || clave < claves[padre]) izq[padre] = nuevo;
+        else                                    der[padre] = nuevo;
+        numNodos++;
+        return true;
+    }
+
+    /**
+     * Busca una clave
+     * RETORNA: id_info de la clave o -1 si no existe
+     */
+    constexpr int buscar(int clave) const{
+        Indice padre = 0;
+        Indice posicion = ubicar(clave, padre);
+        return posicion != 0 ? ids[posicion] : -1;
+    }
+
+    /**
+     * Cambia el id_info de una clave
+     * RETORNA: false si la clave no existe
+     */
+    constexpr bool modificar(int clave, int nuevoId){
+        Indice padre = 0;
+        Indice posicion = ubicar(clave, padre);
+        if(posicion == 0) return false;
+        ids[posicion] = nuevoId;
+        return true;
+    }
+
+    /**
+     * Elimina una clave (mismos tres casos que ArbolBinarioOrdenado::eliminar)
+     * La posicion que queda libre se agrega a la lista de libres
+     * RETORNA: false si la clave no existe
+     */
+    constexpr bool eliminar(int clave){
+        Indice padre = 0;
+        Indice actual = ubicar(clave, padre);
+        if(actual == 0) return false;
+
+        // CASO 3: Dos hijos: copiar el sucesor inorden y eliminarlo a el
+        if(izq[actual] != 0 && der[actual] != 0){
+            Indice padreSucesor = actual;
+            Indice sucesor = der[actual];
+            while(izq[sucesor] != 0){
+                padreSucesor = sucesor;
+                sucesor = izq[sucesor];
+            }
+            claves[actual] = claves[sucesor];
+            ids[actual] = ids[sucesor];
+            padre = padreSucesor;
+            actual = sucesor;
+        }
+
+        // CASO 1 y 2: Conectar el padre con el unico hijo (o con ninguno)
+        Indice hijo = izq[actual] != 0 ? izq[actual] : der[actual];
+        if(izq[padre] == actual) izq[padre] = hijo;  // Incluye la raiz (padre 0)
+        else                     der[padre] = hijo;
+
+        izq[actual] = der[0];                     // Encadenar en la lista de libres
+        der[actual] = 0;
+        der[0] = actual;
+        numNodos--;
+        return true;
+    }
+
+    /**
+     * Recorridos iterativos
+     * PARaMETROS:
+     * - visitar: funcion llamada con (clave, id_info) de cada nodo en orden
+     *
+     * NOTA: Las pilas y colas auxiliares son arreglos locales de N posiciones
+     * (sin heap); con un visitante constexpr el recorrido tambien lo es
+     */
+    template<typename Visitante>
+    constexpr void inorden(Visitante&& visitar) const{
+        array<Indice, N> pila{};
+        size_t tope = 0;
+        Indice actual = izq[0];
+        while(actual != 0 || tope > 0){
+            while(actual != 0){                   // Ir al extremo izquierdo
+                pila[tope++] = actual;
+                actual = izq[actual];
+            }
+            actual = pila[--tope];
+            visitar(claves[actual], ids[actual]);
+            actual = der[actual];                 // Continuar con derecha
+        }
+    }
+
+    template<typename Visitante>
+    constexpr void preorden(Visitante&& visitar) const{
+        array<Indice, N> pila{};
+        size_t tope = 0;
+        if(izq[0] != 0) pila[tope++] = izq[0];
+        while(tope > 0){
+            Indice actual = pila[--tope];
+            visitar(claves[actual], ids[actual]);
+            if(der[actual] != 0) pila[tope++] = der[actual];  // Derecho primero
+            if(izq[actual] != 0) pila[tope++] = izq[actual];
+        }
+    }
+
+    template<typename Visitante>
+    constexpr void posorden(Visitante&& visitar) const{
+        // Una sola pila: un nodo se visita al volver de su subarbol derecho
+        array<Indice, N> pila{};
+        size_t tope = 0;
+        Indice actual = izq[0];
+        Indice ultimo = 0;                        // Ultimo nodo visitado
+        while(actual != 0 || tope > 0){
+            if(actual != 0){
+                pila[tope++] = actual;
+                actual = izq[actual];
+            }
+            else{
+                Indice cima = pila[tope - 1];
+                if(der[cima] != 0 && der[cima] != ultimo){
+                    actual = der[cima];           // Falta el subarbol derecho
+                }
+                else{
+                    visitar(claves[cima], ids[cima]);
+                    ultimo = cima;
+                    tope--;
+                }
+            }
+        }
+    }
+
+    template<typename Visitante>
+    constexpr void porNiveles(Visitante&& visitar) const{
+        array<Indice, N> cola{};                  // Cada nodo entra una sola vez
+        size_t inicio = 0, fin = 0;
+        if(izq[0] != 0) cola[fin++] = izq[0];
+        while(inicio < fin){
+            Indice actual = cola[inicio++];
+            visitar(claves[actual], ids[actual]);
+            if(izq[actual] != 0) cola[fin++] = izq[actual];
+            if(der[actual] != 0) cola[fin++] = der[actual];
+        }
+    }
+
+    // Informacion de capacidad
+    constexpr size_t cantidad() const { return numNodos; }
+    static constexpr size_t capacidad() { return N; }
+    constexpr bool lleno() const { return der[0] == 0 && siguienteLibre > N; }
+};
+
+#endif //ARBOLBINARIOFIJO_H
@@ -0,0 +1,411 @@
+/**
+ * BenchmarkArbol.cpp
+ *
+ * Suite de medicion para ArbolBinarioOrdenado.
+ *
+ * CUBRE:
+ * - insertar, buscar, modificar, eliminar
+ * - Los cuatro recorridos (inorden, preorden, posorden, por niveles)
+ * - guardarArbol / cargarArbol
+ *
+ * DISTRIBUCIONES DE CLAVES:
+ * - ordenada: claves insertadas y consultadas en orden ascendente
+ * - inversa:  claves insertadas y consultadas en orden descendente
+ * - aleatoria: insercion barajada, consultas uniformes
+ * - zipf:     insercion barajada, consultas sesgadas (Zipf s = 1.0)
+ *
+ * MOTORES: cada corrida se repite con MOTOR_BINARIO y MOTOR_BMAS sobre
+ * las mismas claves (columna "motor" del CSV)
+ *
+ * FASES REPORTADAS:
+ * - total:   costo completo de la operacion publica
+ * - arbol:   solo el recorrido del motor (sin tocar archivos)
+ * - archivo: solo el acceso al archivo de datos o al archivo del arbol
+ * - canalizado: la operacion completa con la canalizacion de lecturas activa
+ *
+ * COMPILAR: g++ -std=c++17 -O2 -pthread BenchmarkArbol.cpp -o benchmark
+ * USO:      ./benchmark [salida.csv] [tamaño1 tamaño2 ...]
+ *
+ * El programa trabaja en un directorio temporal para no tocar los archivos
+ * del proyecto, y escribe un CSV (una fila por operacion/fase) que permite
+ * comparar resultados entre versiones.
+ */
+
+#include "ArbolBinOrdenado.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <iomanip>
+#include <random>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Maximo de operaciones con acceso a archivo por corrida (acota el tiempo total)
+const int LIMITE_OPERACIONES_ARCHIVO = 200;
+
+// Repeticiones de las operaciones que recorren el arbol completo
+const int REPETICIONES_COMPLETAS = 3;
+
+// Hilos lectores y tamaño de lote para las mediciones canalizadas
+const int HILOS_CANALIZACION = 4;
+const int LOTE_CANALIZACION = 32;
+
+/**
+ * Buffer que descarta todo lo que se escribe
+ * Se usa para silenciar cout durante los recorridos y eliminaciones
+ */
+class BufferNulo : public streambuf{
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * Redirige cout al buffer nulo mientras exista el objeto
+ */
+class SilenciarSalida{
+private:
+    BufferNulo nulo;
+    streambuf* original;
+public:
+    SilenciarSalida(): original(cout.rdbuf(&nulo)) {}
+    ~SilenciarSalida(){ cout.rdbuf(original); }
+};
+
+/**
+ * Conjunto de latencias (en nanosegundos) de una operacion/fase
+ */
+struct Muestra{
+    string operacion;               // insertar, buscar, inorden, ...
+    string fase;                    // total, arbol o archivo
+    vector<long long> latencias;    // Latencia de cada operacion individual
+};
+
+enum class Distribucion { ORDENADA, INVERSA, ALEATORIA, ZIPF };
+
+string nombreMotor(MotorArbol motor){
+    return motor == MOTOR_BMAS ? "bmas" : "binario";
+}
+
+string nombreDistribucion(Distribucion d){
+    switch(d){
+        case Distribucion::ORDENADA:  return "ordenada";
+        case Distribucion::INVERSA:   return "inversa";
+        case Distribucion::ALEATORIA: return "aleatoria";
+        default:                      return "zipf";
+    }
+}
+
+/**
+ * Mide la duracion de una funcion en nanosegundos
+ */
+template<typename F>
+long long medir(F&& funcion){
+    auto inicio = chrono::steady_clock::now();
+    funcion();
+    auto fin = chrono::steady_clock::now();
+    return chrono::duration_cast<chrono::nanoseconds>(fin - inicio).count();
+}
+
+/**
+ * Percentil p (0-100) de un conjunto de latencias ya ordenado
+ */
+long long percentil(const vector<long long>& ordenadas, double p){
+    if(ordenadas.empty()) return 0;
+    size_t pos = (size_t)ceil(p / 100.0 * ordenadas.size());
+    if(pos > 0) pos--;
+    return ordenadas[min(pos, ordenadas.size() - 1)];
+}
+
+/**
+ * Acceso a los metodos privados del arbol (clase amiga)
+ * Permite medir por separado el costo del arbol y el del archivo
+ */
+class BenchmarkArbol{
+public:
+    // Recorrido puro del motor: retorna el id_info de la clave o -1
+    static int buscarSoloArbol(ArbolBinarioOrdenado& arbol, int clave){
+        if(arbol.motor == MOTOR_BMAS) return arbol.localizarId(clave);
+        int padre = -1;
+        int indice = arbol.buscarPosicion(clave, padre);
+        return indice != -1 ? arbol.arreglo[indice].id_info : -1;
+    }
+
+    // Lectura pura del archivo de datos para un id_info
+    static string leerSoloArchivo(ArbolBinarioOrdenado& arbol, int id){
+        return arbol.leerDelArchivo(id);
+    }
+
+    // Recorrido sin impresion ni lectura de archivo; retorna el numero de nodos
+    static size_t recorridoSoloArbol(ArbolBinarioOrdenado& arbol, const string& tipo){
+        if(arbol.motor == MOTOR_BMAS) return arbol.bmas.entradas().size();
+        if(tipo == "inorden")  return arbol.recorridoInorden().size();
+        if(tipo == "preorden") return arbol.recorridoPreorden().size();
+        if(tipo == "posorden") return arbol.recorridoPostorden().size();
+        return arbol.recorridoPorNiveles().size();
+    }
+};
+
+/**
+ * Genera el orden de insercion de las claves 1..n segun la distribucion
+ */
+vector<int> generarInserciones(Distribucion d, int n, mt19937& generador){
+    vector<int> claves(n);
+    for(int i = 0; i < n; i++){
+        claves[i] = i + 1;
+    }
+
+    if(d == Distribucion::INVERSA){
+        reverse(claves.begin(), claves.end());
+    }
+    else if(d == Distribucion::ALEATORIA || d == Distribucion::ZIPF){
+        shuffle(claves.begin(), claves.end(), generador);
+    }
+    return claves;
+}
+
+/**
+ * Genera 'm' claves de consulta segun la distribucion
+ * En zipf, el rango k tiene probabilidad proporcional a 1/k y los rangos
+ * se asignan a claves al azar para que las claves calientes no sean
+ * siempre las menores del arbol
+ */
+vector<int> generarConsultas(Distribucion d, int n, int m, mt19937& generador){
+    vector<int> consultas;
+    consultas.reserve(m);
+
+    if(d == Distribucion::ORDENADA || d == Distribucion::INVERSA){
+        // Barrido uniforme del rango de claves en el orden de la distribucion
+        for(int i = 0; i < m; i++){
+            int clave = (int)((long long)i * n / m) + 1;
+            consultas.push_back(d == Distribucion::ORDENADA ? clave : n + 1 - clave);
+        }
+    }
+    else if(d == Distribucion::ALEATORIA){
+        uniform_int_distribution<int> uniforme(1, n);
+        for(int i = 0; i < m; i++){
+            consultas.push_back(uniforme(generador));
+        }
+    }
+    else{
+        // Funcion de distribucion acumulada de Zipf con s = 1.0
+        vector<double> acumulada(n);
+        double suma = 0.0;
+        for(int k = 1; k <= n; k++){
+            suma += 1.0 / k;
+            acumulada[k - 1] = suma;
+        }
+
+        vector<int> claveDeRango = generarInserciones(Distribucion::ALEATORIA, n, generador);
+        uniform_real_distribution<double> uniforme(0.0, suma);
+        for(int i = 0; i < m; i++){
+            size_t rango = lower_bound(acumulada.begin(), acumulada.end(), uniforme(generador)) - acumulada.begin();
+            consultas.push_back(claveDeRango[min(rango, (size_t)n - 1)]);
+        }
+    }
+    return consultas;
+}
+
+/**
+ * Genera la informacion de un estudiante con el mismo formato del archivo de ejemplo
+ */
+string generarInformacion(int clave){
+    static const char* nombres[]  = {"Ana Garcia", "Carlos Lopez", "Diego Morales", "Elena Vargas",
+                                     "Jose Martinez", "Laura Fernandez", "Maria Rodriguez", "Sofia Torres"};
+    static const char* carreras[] = {"Ingenieria De Sistemas", "Ingenieria Electronica",
+                                     "Ingenieria Catastral", "Ingenieria Industrial"};
+    static const char* deportes[] = {"Danza", "Beisbol", "Natacion", "Basquet"};
+
+    return string(nombres[clave % 8]) + "|" + carreras[clave % 4] + "|" +
+           deportes[(clave / 4) % 4] + "|" + to_string(18 + clave % 10);
+}
+
+/**
+ * Borra los archivos que usa el arbol para empezar cada corrida desde cero
+ */
+void limpiarArchivos(){
+    remove("estudiantes.dat");
+    remove("estudiantes.txt");
+    remove("arbol_guardado.dat");
+    remove("indices_guardados.dat");
+    remove("arbol_bmas.dat");
+    remove("indices_bmas.dat");
+}
+
+/**
+ * Ejecuta todas las operaciones para una distribucion, un tamaño y un motor
+ * RETORNA: Muestras de latencia de cada operacion/fase
+ * (deque: las referencias a muestras anteriores siguen validas al agregar)
+ */
+deque<Muestra> ejecutarCorrida(Distribucion d, int n, MotorArbol motor, mt19937& generador){
+    deque<Muestra> muestras;
+    auto nuevaMuestra = [&](const string& operacion, const string& fase) -> Muestra& {
+        muestras.push_back({operacion, fase, {}});
+        return muestras.back();
+    };
+
+    limpiarArchivos();
+    vector<int> inserciones = generarInserciones(d, n, generador);
+    int m = min(n, LIMITE_OPERACIONES_ARCHIVO);
+    vector<int> consultas = generarConsultas(d, n, m, generador);
+
+    {
+        ArbolBinarioOrdenado arbol(n, motor);
+
+        // INSERTAR: la fase arbol mide la busqueda de la posicion de insercion
+        Muestra& insertarTotal = nuevaMuestra("insertar", "total");
+        Muestra& insertarArbol = nuevaMuestra("insertar", "arbol");
+        for(int clave : inserciones){
+            string info = generarInformacion(clave);
+            insertarArbol.latencias.push_back(medir([&]{ BenchmarkArbol::buscarSoloArbol(arbol, clave); }));
+            insertarTotal.latencias.push_back(medir([&]{ arbol.insertar(clave, info); }));
+        }
+
+        // BUSCAR: total = arbol + archivo
+        Muestra& buscarTotal   = nuevaMuestra("buscar", "total");
+        Muestra& buscarArbol   = nuevaMuestra("buscar", "arbol");
+        Muestra& buscarArchivo = nuevaMuestra("buscar", "archivo");
+        for(int clave : consultas){
+            int id = -1;
+            buscarTotal.latencias.push_back(medir([&]{ arbol.buscar(clave); }));
+            buscarArbol.latencias.push_back(medir([&]{ id = BenchmarkArbol::buscarSoloArbol(arbol, clave); }));
+            if(id != -1){
+                buscarArchivo.latencias.push_back(medir([&]{ BenchmarkArbol::leerSoloArchivo(arbol, id); }));
+            }
+        }
+
+        // RECORRIDOS: cada muestra es un recorrido completo
+        const string tipos[] = {"inorden", "preorden", "posorden", "porNiveles"};
+        for(const string& tipo : tipos){
+            Muestra& recorridoTotal = nuevaMuestra(tipo, "total");
+            Muestra& recorridoArbol = nuevaMuestra(tipo, "arbol");
+            for(int r = 0; r < REPETICIONES_COMPLETAS; r++){
+                SilenciarSalida silencio;
+                recorridoTotal.latencias.push_back(medir([&]{
+                    if(tipo == "inorden")       arbol.inorden();
+                    else if(tipo == "preorden") arbol.preorden();
+                    else if(tipo == "posorden") arbol.posorden();
+                    else                        arbol.porNiveles();
+                }));
+                recorridoArbol.latencias.push_back(medir([&]{ BenchmarkArbol::recorridoSoloArbol(arbol, tipo); }));
+            }
+        }
+
+        // CANALIZACION: inorden y buscarVarios con lectura anticipada de registros
+        Muestra& variosTotal      = nuevaMuestra("buscarVarios", "total");
+        Muestra& variosCanalizado = nuevaMuestra("buscarVarios", "canalizado");
+        Muestra& inordenCanalizado = nuevaMuestra("inorden", "canalizado");
+        for(int r = 0; r < REPETICIONES_COMPLETAS; r++){
+            variosTotal.latencias.push_back(medir([&]{ arbol.buscarVarios(consultas); }));
+        }
+        arbol.configurarCanalizacion(HILOS_CANALIZACION, LOTE_CANALIZACION);
+        for(int r = 0; r < REPETICIONES_COMPLETAS; r++){
+            SilenciarSalida silencio;
+            variosCanalizado.latencias.push_back(medir([&]{ arbol.buscarVarios(consultas); }));
+            inordenCanalizado.latencias.push_back(medir([&]{ arbol.inorden(); }));
+        }
+        arbol.configurarCanalizacion(0, 0);
+
+        // MODIFICAR
+        Muestra& modificarTotal = nuevaMuestra("modificar", "total");
+        for(int clave : consultas){
+            string info = generarInformacion(clave + 1);
+            modificarTotal.latencias.push_back(medir([&]{ arbol.modificar(clave, info); }));
+        }
+
+        // GUARDAR / CARGAR: solo archivo del arbol
+        Muestra& guardarArchivo = nuevaMuestra("guardarArbol", "archivo");
+        Muestra& cargarArchivo  = nuevaMuestra("cargarArbol", "archivo");
+        for(int r = 0; r < REPETICIONES_COMPLETAS; r++){
+            guardarArchivo.latencias.push_back(medir([&]{ arbol.guardarArbol(); }));
+            cargarArchivo.latencias.push_back(medir([&]{ arbol.cargarArbol(); }));
+        }
+
+        // ELIMINAR: claves distintas tomadas de las consultas
+        Muestra& eliminarTotal = nuevaMuestra("eliminar", "total");
+        vector<int> aEliminar = consultas;
+        sort(aEliminar.begin(), aEliminar.end());
+        aEliminar.erase(unique(aEliminar.begin(), aEliminar.end()), aEliminar.end());
+        shuffle(aEliminar.begin(), aEliminar.end(), generador);
+        {
+            SilenciarSalida silencio;
+            for(int clave : aEliminar){
+                eliminarTotal.latencias.push_back(medir([&]{ arbol.eliminar(clave); }));
+            }
+        }
+    }
+
+    limpiarArchivos();
+    return muestras;
+}
+
+int main(int argc, char* argv[]){
+    string salida = argc > 1 ? argv[1] : "resultados_benchmark.csv";
+    vector<int> tamaños;
+    for(int i = 2; i < argc; i++){
+        tamaños.push_back(atoi(argv[i]));
+    }
+    if(tamaños.empty()){
+        tamaños = {100, 500, 2000};
+    }
+
+    // Trabajar en un directorio temporal para no tocar los archivos del proyecto
+    fs::path rutaSalida = fs::absolute(salida);
+    fs::path directorio = fs::temp_directory_path() / "arbol_benchmark";
+    fs::create_directories(directorio);
+    fs::path directorioOriginal = fs::current_path();
+    fs::current_path(directorio);
+
+    ofstream csv(rutaSalida);
+    csv << "motor,distribucion,n,operacion,fase,operaciones,total_ms,ops_por_seg,p50_us,p99_us\n";
+
+    cout << left << setw(9) << "motor" << setw(10) << "dist" << setw(8) << "n" << setw(14) << "operacion"
+         << setw(9) << "fase" << right << setw(8) << "ops" << setw(14) << "ops/seg"
+         << setw(12) << "p50(us)" << setw(12) << "p99(us)" << endl;
+
+    mt19937 generador(42);                        // Semilla fija: corridas reproducibles
+    const Distribucion distribuciones[] = {Distribucion::ORDENADA, Distribucion::INVERSA,
+                                           Distribucion::ALEATORIA, Distribucion::ZIPF};
+
+    const MotorArbol motores[] = {MOTOR_BINARIO, MOTOR_BMAS};
+
+    for(Distribucion d : distribuciones){
+        for(int n : tamaños){
+            // Ambos motores reciben las mismas claves: cada uno parte del mismo estado del generador
+            mt19937 estadoInicial = generador;
+            for(MotorArbol motor : motores){
+                generador = estadoInicial;
+                for(Muestra& muestra : ejecutarCorrida(d, n, motor, generador)){
+                    vector<long long>& lat = muestra.latencias;
+                    sort(lat.begin(), lat.end());
+
+                    long long totalNs = 0;
+                    for(long long l : lat) totalNs += l;
+                    double opsPorSeg = totalNs > 0 ? lat.size() * 1e9 / totalNs : 0.0;
+                    double p50 = percentil(lat, 50) / 1000.0;
+                    double p99 = percentil(lat, 99) / 1000.0;
+
+                    csv << nombreMotor(motor) << "," << nombreDistribucion(d) << "," << n << ","
+                        << muestra.operacion << "," << muestra.fase << "," << lat.size() << ","
+                        << fixed << setprecision(3) << totalNs / 1e6 << "," << opsPorSeg << ","
+                        << p50 << "," << p99 << "\n";
+
+                    cout << left << setw(9) << nombreMotor(motor) << setw(10) << nombreDistribucion(d)
+                         << setw(8) << n << setw(14) << muestra.operacion << setw(9) << muestra.fase << right
+                         << setw(8) << lat.size() << fixed << setprecision(1) << setw(14) << opsPorSeg
+                         << setprecision(2) << setw(12) << p50 << setw(12) << p99 << endl;
+                }
+            }
+        }
+    }
+
+    csv.close();
+    fs::current_path(directorioOriginal);
+    fs::remove_all(directorio);
+    cout << "\nResultados escritos en " << rutaSalida.string() << endl;
+    return 0;
+}
@@ -0,0 +1,271 @@
+#ifndef CANALIZACIONLECTURAS_H
+#define CANALIZACIONLECTURAS_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "RegistroEstudiante.h"
+
+using namespace std;
+
+/**
+ * Clase CanalizacionLecturas
+ *
+ * Lee registros del archivo de datos en paralelo mientras el llamador sigue
+ * trabajando con el arbol, y los entrega en el mismo orden en que se pidieron.
+ *
+ * FUNCIONAMIENTO:
+ * 1. El llamador produce IDs (por ejemplo, siguiendo un recorrido)
+ * 2. Los IDs se agrupan en lotes de 'tamLote' y cada lote se encola
+ * 3. Un grupo pequeño de hilos lee los lotes; cada hilo tiene su propio
+ *    ifstream, asi que las lecturas posicionadas no comparten estado
+ * 4. Dentro de un lote las lecturas se ordenan por posicion y los registros
+ *    cercanos se leen de una vez. Un registro se une al grupo si el hueco
+ *    que lo separa no supera HUECO_POR_REGISTRO veces su longitud (ni
+ *    HUECO_MAXIMO bytes) y la lectura no pasa de LECTURA_MAXIMA bytes: con
+ *    registros dispersos no se lee medio archivo para aprovechar unos pocos
+ * 5. Se mantienen hasta 2 lotes por hilo en vuelo: mientras se entrega un
+ *    lote, los siguientes ya se estan leyendo
+ *
+ * COMPILAR: requiere -pthread
+ */
+class CanalizacionLecturas{
+private:
+    static constexpr long long HUECO_POR_REGISTRO = 4;      // Hueco admitido, en longitudes del registro
+    static constexpr long long HUECO_MAXIMO = 512;          // Bytes intermedios que se leen para unir lecturas
+    static constexpr long long LECTURA_MAXIMA = 64 * 1024;  // Tamaño maximo de una lectura agrupada
+
+    string archivo;                                 // Archivo de datos
+    int tamLote;                                    // IDs por lote
+    vector<thread> hilos;                           // Hilos lectores
+    mutex cerrojo;                                  // Protege 'tareas' y 'terminar'
+    condition_variable hayTrabajo;                  // Avisa a los hilos de tareas nuevas
+    deque<function<void(ifstream&)>> tareas;        // Lotes pendientes
+    bool terminar;                                  // Señal de cierre para los hilos
+
+    // Ciclo de cada hilo: abrir su lector y atender tareas
+    void trabajar();
+
+    /**
+     * Lee un lote completo con lecturas agrupadas
+     * RETORNA: Texto de cada registro en el orden del lote (vacio si no existe)
+     */
+    vector<optional<string>> leerLote(ifstream& entrada, const vector<UbicacionRegistro>& lote);
+
+    // Encola un lote y retorna el futuro con sus resultados
+    future<vector<optional<string>>> encolar(vector<UbicacionRegistro> lote);
+
+public:
+#ifdef ARBOL_ESTADISTICAS
+    atomic<unsigned long long> bytesLeidos;         // Bytes leidos por los hilos (con huecos)
+    atomic<unsigned long long> bytesUtiles;         // Bytes de los registros entregados
+    atomic<unsigned long long> lecturasFisicas;     // Lecturas al archivo tras agrupar
+#endif
+
+    CanalizacionLecturas();
+    ~CanalizacionLecturas();
+
+    /**
+     * Inicia los hilos lectores (detiene los anteriores si habia)
+     * PARaMETROS:
+     * - archivoDatos: Archivo a leer
+     * - numHilos: Hilos lectores (0 deja la canalizacion inactiva)
+     * - lote: IDs por lote
+     */
+    void iniciar(const string& archivoDatos, int numHilos, int lote);
+
+    /**
+     * Detiene y espera a los hilos lectores
+     */
+    void detener();
+
+    /**
+     * true si hay hilos lectores en marcha
+     */
+    bool activa();
+
+    /**
+     * Lee 'total' registros en orden
+     * PARaMETROS:
+     * - datos: Archivo de registros (solo se consulta su indice desde este hilo)
+     * - total: Numero de registros a leer
+     * - producir: Funcion que retorna el siguiente ID (-1 si no hay registro)
+     * - entregar: Funcion que recibe cada resultado en orden (nullopt si no existe)
+     */
+    template<typename Productor, typename Consumidor>
+    void procesar(ArchivoRegistros& datos, size_t total, Productor producir, Consumidor entregar);
+};
+
+// ===============================
+// IMPLEMENTACIoN DE LA CANALIZACIoN
+// ===============================
+
+CanalizacionLecturas::CanalizacionLecturas(): tamLote(32), terminar(false){
+#ifdef ARBOL_ESTADISTICAS
+    bytesLeidos = 0;
+    bytesUtiles = 0;
+    lecturasFisicas = 0;
+#endif
+}
+
+CanalizacionLecturas::~CanalizacionLecturas(){
+    detener();
+}
+
+void CanalizacionLecturas::iniciar(const string& archivoDatos, int numHilos, int lote){
+    detener();
+    archivo = archivoDatos;
+    tamLote = lote > 0 ? lote : 1;
+    terminar = false;
+    for(int i = 0; i < numHilos; i++){
+        hilos.emplace_back(&CanalizacionLecturas::trabajar, this);
+    }
+}
+
+void CanalizacionLecturas::detener(){
+    {
+        lock_guard<mutex> guardia(cerrojo);
+        terminar = true;
+    }
+    hayTrabajo.notify_all();
+    for(thread& hilo : hilos){
+        hilo.join();
+    }
+    hilos.clear();
+    tareas.clear();
+}
+
+bool CanalizacionLecturas::activa(){
+    return !hilos.empty();
+}
+
+void CanalizacionLecturas::trabajar(){
+    ifstream entrada(archivo, ios::binary);       // Lector propio de este hilo
+    while(true){
+        function<void(ifstream&)> tarea;
+        {
+            unique_lock<mutex> guardia(cerrojo);
+            hayTrabajo.wait(guardia, [this]{ return terminar || !tareas.empty(); });
+            if(terminar && tareas.empty()) return;
+            tarea = move(tareas.front());
+            tareas.pop_front();
+        }
+        tarea(entrada);
+    }
+}
+
+future<vector<optional<string>>> CanalizacionLecturas::encolar(vector<UbicacionRegistro> lote){
+    auto promesa = make_shared<promise<vector<optional<string>>>>();
+    future<vector<optional<string>>> resultado = promesa->get_future();
+    {
+        lock_guard<mutex> guardia(cerrojo);
+        tareas.push_back([this, promesa, lote = move(lote)](ifstream& entrada){
+            promesa->set_value(leerLote(entrada, lote));
+        });
+    }
+    hayTrabajo.notify_one();
+    return resultado;
+}
+
+vector<optional<string>> CanalizacionLecturas::leerLote(ifstream& entrada, const vector<UbicacionRegistro>& lote){
+    vector<optional<string>> resultados(lote.size());
+
+    // Orden de lectura: por posicion en el archivo (solo registros existentes)
+    vector<size_t> orden;
+    for(size_t i = 0; i < lote.size(); i++){
+        if(lote[i].longitud > 0) orden.push_back(i);
+    }
+    sort(orden.begin(), orden.end(), [&](size_t a, size_t b){ return lote[a].posicion < lote[b].posicion; });
+
+    string bloque;
+    size_t i = 0;
+    while(i < orden.size()){
+        // Extender el grupo mientras el siguiente registro este cerca
+        // (hueco proporcional a su longitud y lectura total acotada)
+        long long inicio = lote[orden[i]].posicion;
+        long long fin = inicio + lote[orden[i]].longitud;
+        size_t j = i + 1;
+        while(j < orden.size()){
+            const UbicacionRegistro& siguiente = lote[orden[j]];
+            long long hueco = siguiente.posicion - fin;
+            long long nuevoFin = max(fin, siguiente.posicion + (long long)siguiente.longitud);
+            if(hueco > min(HUECO_MAXIMO, HUECO_POR_REGISTRO * siguiente.longitud) ||
+               nuevoFin - inicio > LECTURA_MAXIMA){
+                break;
+            }
+            fin = nuevoFin;
+            j++;
+        }
+
+        // Una sola lectura para todo el grupo
+        bloque.resize(fin - inicio);
+        entrada.clear();
+        entrada.seekg(inicio);
+        entrada.read(&bloque[0], bloque.size());
+        bool completo = entrada.gcount() == (streamsize)bloque.size();
+#ifdef ARBOL_ESTADISTICAS
+        bytesLeidos += entrada.gcount();
+        lecturasFisicas++;
+#endif
+
+        // Separar cada registro del bloque
+        for(size_t k = i; k < j && completo; k++){
+            const UbicacionRegistro& u = lote[orden[k]];
+            string texto;
+            ArchivoRegistros::decodificarTexto(string_view(bloque).substr(u.posicion - inicio, u.longitud), texto);
+            resultados[orden[k]] = move(texto);
+#ifdef ARBOL_ESTADISTICAS
+            bytesUtiles += u.longitud;
+#endif
+        }
+        i = j;
+    }
+    return resultados;
+}
+
+template<typename Productor, typename Consumidor>
+void CanalizacionLecturas::procesar(ArchivoRegistros& datos, size_t total, Productor producir, Consumidor entregar){
+    deque<future<vector<optional<string>>>> enVuelo;
+    size_t maximoEnVuelo = 2 * hilos.size();
+    size_t enviados = 0;
+
+    // Producir el siguiente lote (trabajo del arbol) y encolarlo
+    auto enviarLote = [&](){
+        vector<UbicacionRegistro> lote;
+        lote.reserve(tamLote);
+        while((int)lote.size() < tamLote && enviados < total){
+            int id = producir();
+            lote.push_back(id != -1 ? datos.ubicacion(id) : UbicacionRegistro{0, 0});
+            enviados++;
+        }
+        enVuelo.push_back(encolar(move(lote)));
+    };
+
+    while(enVuelo.size() < maximoEnVuelo && enviados < total){
+        enviarLote();                             // Llenar la ventana inicial
+    }
+
+    while(!enVuelo.empty()){
+        vector<optional<string>> resultados = enVuelo.front().get();
+        enVuelo.pop_front();
+        if(enviados < total){
+            enviarLote();                         // Mantener la ventana llena antes de entregar
+        }
+        for(optional<string>& resultado : resultados){
+            entregar(resultado);
+        }
+    }
+}
+
+#endif //CANALIZACIONLECTURAS_H
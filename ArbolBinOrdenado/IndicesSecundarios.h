@@ -0,0 +1,355 @@
+#ifndef INDICESSECUNDARIOS_H
+#define INDICESSECUNDARIOS_H
+
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+
+#include "RegistroEstudiante.h"
+
+using namespace std;
+
+/**
+ * Campos que se pueden indexar (se combinan como mascara de bits)
+ */
+enum IndiceCampo{
+    INDICE_CARRERA = 1,
+    INDICE_DEPORTE = 2,
+    INDICE_EDAD    = 4,
+    INDICE_TODOS   = 7
+};
+
+/**
+ * Clase IndicesSecundarios
+ *
+ * Indices opcionales sobre campos del registro de estudiante.
+ * Cada indice asocia un valor del campo con una lista de id_info.
+ *
+ * CARACTERiSTICAS:
+ * - Listas de id_info ordenadas ascendentemente y sin repetidos
+ *   (los IDs nuevos son siempre mayores, asi que agregar suele ser push_back)
+ * - carrera/deporte: igualdad; edad: igualdad y rango
+ * - Las consultas no leen el archivo de datos: solo devuelven los id_info
+ *   de los registros que cumplen la condicion
+ *
+ * FORMATO DEL ARCHIVO (indices_guardados.dat):
+ * - Firma "IDX2", mascara (u8), sello del arbol (varint)
+ * - Por cada indice habilitado: numero de valores (varint) y por cada valor
+ *   [valor][cantidad de IDs][primer ID][diferencias entre IDs], todo en varint
+ *   (los textos se guardan como longitud varint + bytes)
+ */
+class IndicesSecundarios{
+private:
+    int mascara;                                    // Indices habilitados
+    map<string, vector<int>, less<>> porCarrera;    // carrera -> id_info
+    map<string, vector<int>, less<>> porDeporte;    // deporte -> id_info
+    map<int, vector<int>> porEdad;                  // edad    -> id_info
+
+    // Inserta/quita un id manteniendo la lista ordenada
+    static void agregarA(vector<int>& lista, int id);
+    static void quitarDe(vector<int>& lista, int id);
+
+    // Quita un id de la lista asociada a un texto y borra la entrada si queda vacia
+    static void quitarDeTexto(map<string, vector<int>, less<>>& indice, string_view valor, int id);
+
+    // Escritura y lectura de las listas en formato varint
+    static void codificarLista(string& destino, const vector<int>& lista);
+    static bool decodificarLista(string_view origen, size_t& pos, vector<int>& lista);
+
+public:
+    IndicesSecundarios();
+
+    /**
+     * Mascara de indices habilitados (combinacion de IndiceCampo)
+     */
+    int habilitados();
+
+    /**
+     * Cambia los indices habilitados
+     * Los indices que se deshabilitan se vacian; los nuevos quedan vacios
+     * y deben llenarse con agregar()
+     * RETORNA: Mascara de los indices que quedaron por llenar
+     */
+    int habilitar(int nuevaMascara);
+
+    /**
+     * Registra un registro en los indices habilitados
+     */
+    void agregar(int id, string_view carrera, string_view deporte, int edad);
+
+    /**
+     * Registra un registro solo en los indices indicados por 'soloMascara'
+     * (se usa al construir indices recien habilitados)
+     */
+    void agregar(int id, string_view carrera, string_view deporte, int edad, int soloMascara);
+
+    /**
+     * Quita un registro de los indices habilitados
+     */
+    void quitar(int id, string_view carrera, string_view deporte, int edad);
+
+    /**
+     * Consultas por igualdad y por rango
+     * RETORNAN: id_info ordenados ascendentemente (vacio si el indice no esta
+     * habilitado o si edadMinima > edadMaxima)
+     */
+    vector<int> consultarCarrera(string_view carrera);
+    vector<int> consultarDeporte(string_view deporte);
+    vector<int> consultarEdad(int edadMinima, int edadMaxima);
+
+    /**
+     * Interseccion de dos listas ordenadas en O(|a| + |b|)
+     */
+    static vector<int> intersectar(const vector<int>& a, const vector<int>& b);
+
+    /**
+     * Guarda los indices habilitados en archivo
+     * PARaMETROS:
+     * - selloArbol: Valor que identifica el contenido del arbol guardado
+     *   (cambia con cualquier cambio del arbol); se compara al cargar
+     */
+    void guardar(const string& archivo, uint64_t selloArbol);
+
+    /**
+     * Carga indices desde archivo
+     * RETORNA: true si el archivo existe, es valido y fue guardado con
+     * 'selloArbol'; si no, los indices quedan vacios
+     */
+    bool cargar(const string& archivo, uint64_t selloArbol);
+};
+
+// ===============================
+// IMPLEMENTACIoN DE INDICES SECUNDARIOS
+// ===============================
+
+IndicesSecundarios::IndicesSecundarios(): mascara(0) {}
+
+int IndicesSecundarios::habilitados(){
+    return mascara;
+}
+
+int IndicesSecundarios::habilitar(int nuevaMascara){
+    nuevaMascara &= INDICE_TODOS;
+    if(!(nuevaMascara & INDICE_CARRERA)) porCarrera.clear();
+    if(!(nuevaMascara & INDICE_DEPORTE)) porDeporte.clear();
+    if(!(nuevaMascara & INDICE_EDAD))    porEdad.clear();
+
+    int porLlenar = nuevaMascara & ~mascara;      // Recien habilitados
+    mascara = nuevaMascara;
+    return porLlenar;
+}
+
+void IndicesSecundarios::agregarA(vector<int>& lista, int id){
+    if(lista.empty() || lista.back() < id){
+        lista.push_back(id);                      // Caso comun: ID nuevo, el mayor
+        return;
+    }
+    auto pos = lower_bound(lista.begin(), lista.end(), id);
+    if(pos == lista.end() || *pos != id){
+        lista.insert(pos, id);
+    }
+}
+
+void IndicesSecundarios::quitarDe(vector<int>& lista, int id){
+    auto pos = lower_bound(lista.begin(), lista.end(), id);
+    if(pos != lista.end() && *pos == id){
+        lista.erase(pos);
+    }
+}
+
+void IndicesSecundarios::quitarDeTexto(map<string, vector<int>, less<>>& indice, string_view valor, int id){
+    auto entrada = indice.find(valor);
+    if(entrada == indice.end()) return;
+    quitarDe(entrada->second, id);
+    if(entrada->second.empty()){
+        indice.erase(entrada);                    // No dejar valores sin registros
+    }
+}
+
+void IndicesSecundarios::agregar(int id, string_view carrera, string_view deporte, int edad){
+    agregar(id, carrera, deporte, edad, mascara);
+}
+
+void IndicesSecundarios::agregar(int id, string_view carrera, string_view deporte, int edad, int soloMascara){
+    soloMascara &= mascara;
+
+    if(soloMascara & INDICE_CARRERA){
+        auto entrada = porCarrera.find(carrera);  // Busqueda sin crear un string
+        if(entrada == porCarrera.end()){
+            entrada = porCarrera.emplace(string(carrera), vector<int>()).first;
+        }
+        agregarA(entrada->second, id);
+    }
+    if(soloMascara & INDICE_DEPORTE){
+        auto entrada = porDeporte.find(deporte);
+        if(entrada == porDeporte.end()){
+            entrada = porDeporte.emplace(string(deporte), vector<int>()).first;
+        }
+        agregarA(entrada->second, id);
+    }
+    if(soloMascara & INDICE_EDAD){
+        agregarA(porEdad[edad], id);
+    }
+}
+
+void IndicesSecundarios::quitar(int id, string_view carrera, string_view deporte, int edad){
+    if(mascara & INDICE_CARRERA) quitarDeTexto(porCarrera, carrera, id);
+    if(mascara & INDICE_DEPORTE) quitarDeTexto(porDeporte, deporte, id);
+    if(mascara & INDICE_EDAD){
+        auto entrada = porEdad.find(edad);
+        if(entrada != porEdad.end()){
+            quitarDe(entrada->second, id);
+            if(entrada->second.empty()) porEdad.erase(entrada);
+        }
+    }
+}
+
+vector<int> IndicesSecundarios::consultarCarrera(string_view carrera){
+    auto entrada = porCarrera.find(carrera);
+    return entrada != porCarrera.end() ? entrada->second : vector<int>();
+}
+
+vector<int> IndicesSecundarios::consultarDeporte(string_view deporte){
+    auto entrada = porDeporte.find(deporte);
+    return entrada != porDeporte.end() ? entrada->second : vector<int>();
+}
+
+vector<int> IndicesSecundarios::consultarEdad(int edadMinima, int edadMaxima){
+    vector<int> resultado;
+    if(edadMinima > edadMaxima){
+        return resultado;                         // Rango vacio: fin quedaria antes de inicio
+    }
+    auto inicio = porEdad.lower_bound(edadMinima);
+    auto fin = porEdad.upper_bound(edadMaxima);
+
+    // Una sola edad: la lista ya esta ordenada
+    if(inicio != fin && next(inicio) == fin){
+        return inicio->second;
+    }
+
+    // Varias edades: concatenar y ordenar (los IDs no se repiten entre edades)
+    for(auto entrada = inicio; entrada != fin; ++entrada){
+        resultado.insert(resultado.end(), entrada->second.begin(), entrada->second.end());
+    }
+    sort(resultado.begin(), resultado.end());
+    return resultado;
+}
+
+vector<int> IndicesSecundarios::intersectar(const vector<int>& a, const vector<int>& b){
+    vector<int> resultado;
+    size_t i = 0, j = 0;
+    while(i < a.size() && j < b.size()){
+        if(a[i] < b[j])      i++;
+        else if(b[j] < a[i]) j++;
+        else{
+            resultado.push_back(a[i]);
+            i++;
+            j++;
+        }
+    }
+    return resultado;
+}
+
+void IndicesSecundarios::codificarLista(string& destino, const vector<int>& lista){
+    escribirVarint(destino, lista.size());
+    int anterior = 0;
+    for(int id : lista){
+        escribirVarint(destino, (uint64_t)(id - anterior));  // Diferencias: lista ordenada
+        anterior = id;
+    }
+}
+
+bool IndicesSecundarios::decodificarLista(string_view origen, size_t& pos, vector<int>& lista){
+    uint64_t cantidad, diferencia;
+    if(!leerVarint(origen, pos, cantidad)) return false;
+
+    lista.clear();
+    lista.reserve(cantidad);
+    int anterior = 0;
+    for(uint64_t i = 0; i < cantidad; i++){
+        if(!leerVarint(origen, pos, diferencia)) return false;
+        anterior += (int)diferencia;
+        lista.push_back(anterior);
+    }
+    return true;
+}
+
+void IndicesSecundarios::guardar(const string& archivo, uint64_t selloArbol){
+    if(mascara == 0){
+        remove(archivo.c_str());                  // Sin indices: no dejar un archivo viejo
+        return;
+    }
+
+    string contenido = "IDX2";
+    contenido.push_back((char)mascara);
+    escribirVarint(contenido, selloArbol);
+
+    for(auto* indice : {&porCarrera, &porDeporte}){
+        if(!(mascara & (indice == &porCarrera ? INDICE_CARRERA : INDICE_DEPORTE))) continue;
+        escribirVarint(contenido, indice->size());
+        for(auto& entrada : *indice){
+            escribirVarint(contenido, entrada.first.size());
+            contenido.append(entrada.first);
+            codificarLista(contenido, entrada.second);
+        }
+    }
+    if(mascara & INDICE_EDAD){
+        escribirVarint(contenido, porEdad.size());
+        for(auto& entrada : porEdad){
+            escribirVarint(contenido, entrada.first);
+            codificarLista(contenido, entrada.second);
+        }
+    }
+
+    ofstream salida(archivo, ios::binary);
+    salida.write(contenido.data(), contenido.size());
+}
+
+bool IndicesSecundarios::cargar(const string& archivo, uint64_t selloArbol){
+    ifstream entrada(archivo, ios::binary);
+    if(!entrada.is_open()) return false;
+
+    string contenido((istreambuf_iterator<char>(entrada)), istreambuf_iterator<char>());
+    string_view datos(contenido);
+    if(datos.size() < 5 || datos.substr(0, 4) != "IDX2") return false;
+
+    int mascaraGuardada = (unsigned char)datos[4] & INDICE_TODOS;
+    size_t pos = 5;
+    uint64_t sello, cantidad, longitud, edad;
+    if(!leerVarint(datos, pos, sello) || sello != selloArbol){
+        return false;                             // Indices de otra version del arbol
+    }
+
+    map<string, vector<int>, less<>> carreras, deportes;
+    map<int, vector<int>> edades;
+    for(auto* indice : {&carreras, &deportes}){
+        if(!(mascaraGuardada & (indice == &carreras ? INDICE_CARRERA : INDICE_DEPORTE))) continue;
+        if(!leerVarint(datos, pos, cantidad)) return false;
+        for(uint64_t i = 0; i < cantidad; i++){
+            if(!leerVarint(datos, pos, longitud) || pos + longitud > datos.size()) return false;
+            string valor(datos.substr(pos, longitud));
+            pos += longitud;
+            if(!decodificarLista(datos, pos, (*indice)[valor])) return false;
+        }
+    }
+    if(mascaraGuardada & INDICE_EDAD){
+        if(!leerVarint(datos, pos, cantidad)) return false;
+        for(uint64_t i = 0; i < cantidad; i++){
+            if(!leerVarint(datos, pos, edad)) return false;
+            if(!decodificarLista(datos, pos, edades[(int)edad])) return false;
+        }
+    }
+
+    // Todo se leyo bien: reemplazar el contenido actual
+    mascara = mascaraGuardada;
+    porCarrera.swap(carreras);
+    porDeporte.swap(deportes);
+    porEdad.swap(edades);
+    return true;
+}
+
+#endif //INDICESSECUNDARIOS_H
@@ -0,0 +1,715 @@
+#ifndef REGISTROESTUDIANTE_H
+#define REGISTROESTUDIANTE_H
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+using namespace std;
+
+/**
+ * Codificacion de enteros de longitud variable (LEB128: 7 bits por byte)
+ * Los valores pequeños ocupan un solo byte; la usan los formatos compactos
+ * de los archivos de indices y del arbol
+ */
+void escribirVarint(string& destino, uint64_t valor);
+
+/**
+ * Lee un varint desde 'origen' a partir de 'pos' (que avanza)
+ * RETORNA: false si los datos terminan antes del final del numero
+ */
+bool leerVarint(string_view origen, size_t& pos, uint64_t& valor);
+
+/**
+ * ZigZag: lleva enteros con signo a sin signo (0, -1, 1, -2 -> 0, 1, 2, 3)
+ * para que las diferencias negativas pequeñas tambien ocupen pocos bytes
+ */
+uint64_t aZigZag(int64_t valor);
+int64_t desdeZigZag(uint64_t valor);
+
+/**
+ * Suma de verificacion CRC-32 (polinomio IEEE 0xEDB88320)
+ */
+uint32_t calcularCrc32(string_view datos);
+
+/**
+ * Campos de un registro de estudiante (para lecturas proyectadas)
+ */
+enum CampoEstudiante{
+    CAMPO_NOMBRE, CAMPO_CARRERA, CAMPO_DEPORTE, CAMPO_EDAD
+};
+
+/**
+ * Estructura Estudiante: Registro tipado de la informacion de un nodo
+ *
+ * CAMPOS:
+ * - nombre, carrera, deporte: texto de hasta 255 bytes cada uno
+ * - edad: entero entre 0 y 255
+ *
+ * FORMATO DE TEXTO: "nombre|carrera|deporte|edad"
+ * (el mismo de las lineas de estudiantes.txt)
+ */
+struct Estudiante{
+    string nombre;
+    string carrera;
+    string deporte;
+    int edad;
+
+    // Constructor por defecto: registro vacio
+    Estudiante(): edad(0) {}
+
+    // Constructor con todos los campos
+    Estudiante(string_view n, string_view c, string_view d, int e): nombre(n), carrera(c), deporte(d), edad(e) {}
+
+    /**
+     * Convierte el registro al formato de texto "nombre|carrera|deporte|edad"
+     */
+    string aTexto() const;
+
+    /**
+     * RETORNA: true si el registro cabe en el formato binario (tipo 1):
+     * textos de hasta 255 bytes y edad entre 0 y 255
+     */
+    bool cabeEnFormatoBinario() const;
+
+    /**
+     * Separa un texto "nombre|carrera|deporte|edad" en sus campos sin copiarlos
+     * PARaMETROS:
+     * - texto: Cadena a separar
+     * - partes: Se llena con nombre, carrera y deporte (vistas sobre 'texto')
+     * - edad: Se llena con la edad
+     * RETORNA: true si el texto es un registro valido y su codificacion
+     * binaria reproduce exactamente el mismo texto
+     */
+    static bool separar(string_view texto, string_view partes[3], int& edad);
+
+    /**
+     * Construye un registro a partir de su formato de texto
+     * RETORNA: true si el texto tiene el formato esperado
+     */
+    static bool desdeTexto(string_view texto, Estudiante& salida);
+};
+
+/**
+ * Ubicacion de un registro dentro del archivo (para lecturas externas)
+ * longitud 0 indica que el registro no existe o esta borrado
+ */
+struct UbicacionRegistro{
+    long long posicion;     // Desplazamiento del registro en el archivo
+    unsigned int longitud;  // Bytes de cabecera + cuerpo
+};
+
+/**
+ * Clase ArchivoRegistros
+ *
+ * Archivo binario de registros con indice en memoria (id -> desplazamiento).
+ *
+ * FORMATO DEL ARCHIVO:
+ * - Cabecera del archivo: "EST1"
+ * - Cada registro:
+ *   [estado u8][tipo u8][id u32][longitud del cuerpo u32][cuerpo]
+ *   estado: 1 = vigente, 0 = borrado
+ *   tipo 0 (texto libre): cuerpo = bytes del texto
+ *   tipo 1 (estudiante):  cuerpo = [edad u8][len u8][nombre][len u8][carrera][len u8][deporte]
+ * - Enteros en little-endian, independiente de la maquina
+ *
+ * CARACTERiSTICAS:
+ * - El archivo se abre una sola vez y se mantiene abierto
+ * - Lecturas posicionadas: leer un registro no recorre el archivo
+ * - Borrado logico: marcar un registro cambia un solo byte en su lugar
+ * - Lecturas proyectadas: leer la edad lee un solo byte del registro
+ */
+class ArchivoRegistros{
+private:
+    static constexpr int ID_BASE = 1000;            // Primer ID asignado
+    static constexpr int TAM_CABECERA = 10;         // Bytes de cabecera de cada registro
+    static constexpr const char* FIRMA = "EST1";    // Firma al inicio del archivo
+
+    fstream archivo;                    // Archivo de datos abierto en lectura/escritura
+    string nombre;                      // Ruta del archivo
+    bool abierto;                       // El archivo se pudo abrir y tiene formato valido
+    vector<long long> desplazamientos;  // Posicion de cada registro vigente (-1 si no existe)
+    vector<unsigned int> longitudes;    // Longitud total de cada registro (cabecera + cuerpo)
+    int siguienteId;                    // Proximo ID a entregar
+    long long finArchivo;               // Posicion donde se anexara el proximo registro
+    string buffer;                      // Buffer reutilizable para codificar y leer
+
+    // Escribe/lee enteros de 32 bits en little-endian
+    static void escribirEntero32(char* destino, uint32_t valor);
+    static uint32_t leerEntero32(const char* origen);
+
+    /**
+     * Lee 'n' bytes desde la posicion 'pos' del archivo
+     * RETORNA: true si se leyeron todos los bytes
+     */
+    bool leerEn(long long pos, char* destino, size_t n);
+
+    /**
+     * Anexa un registro vigente al final del archivo y lo indexa
+     * PARaMETROS:
+     * - id: Identificador del registro
+     * - tipo: 0 = texto libre, 1 = estudiante
+     * - cuerpo: Bytes del cuerpo ya codificado
+     */
+    bool anexar(int id, uint8_t tipo, string_view cuerpo);
+
+    /**
+     * Retorna la posicion del registro vigente con ese ID o -1
+     */
+    long long ubicar(int id);
+
+    /**
+     * Registra en el indice la posicion y longitud de un registro
+     */
+    void indexar(int id, long long posicion, unsigned int longitud);
+
+    /**
+     * Recorre el archivo una vez para construir el indice en memoria
+     * RETORNA: false si el archivo no tiene la firma esperada
+     */
+    bool indexarArchivo();
+
+    /**
+     * Importa un archivo de texto con el formato anterior (lineas "ID|informacion")
+     * Las lineas marcadas "ELIMINADO:" o sin ID se omiten
+     */
+    void importarTexto(const string& archivoTexto);
+
+    /**
+     * Codifica un estudiante en 'buffer' (formato de cuerpo tipo 1)
+     */
+    void codificar(string_view nombreEstudiante, string_view carrera, string_view deporte, int edad);
+
+public:
+#ifdef ARBOL_ESTADISTICAS
+    unsigned long long aperturas;       // Veces que se abrio el archivo
+    unsigned long long bytesLeidos;     // Bytes leidos del archivo
+    unsigned long long bytesEscritos;   // Bytes escritos en el archivo
+#endif
+
+    ArchivoRegistros();
+
+    /**
+     * Abre (o crea) el archivo binario de registros
+     * PARaMETROS:
+     * - archivoBinario: Ruta del archivo de registros
+     * - archivoTextoAnterior: Archivo de texto a importar si el binario no existe
+     * RETORNA: true si el archivo quedo listo para usarse
+     */
+    bool abrir(const string& archivoBinario, const string& archivoTextoAnterior);
+
+    /**
+     * Genera un ID unico (mayor que cualquier ID existente en el archivo)
+     */
+    int nuevoId();
+
+    /**
+     * Guarda un registro a partir de texto
+     * Si el texto tiene formato "nombre|carrera|deporte|edad" se guarda como
+     * estudiante (tipo 1); si no, como texto libre (tipo 0)
+     */
+    bool guardar(int id, string_view texto);
+
+    /**
+     * Guarda un registro tipado de estudiante
+     */
+    bool guardar(int id, const Estudiante& estudiante);
+
+    /**
+     * Lee un registro en su formato de texto
+     * PARaMETROS:
+     * - salida: Se reutiliza su memoria para evitar reservas
+     * RETORNA: false si el registro no existe o esta borrado
+     */
+    bool leerTexto(int id, string& salida);
+
+    /**
+     * Lee un registro completo como estudiante
+     * RETORNA: false si no existe o no tiene formato de estudiante
+     */
+    bool leerEstudiante(int id, Estudiante& salida);
+
+    /**
+     * Ruta del archivo (para abrir lectores independientes)
+     */
+    const string& nombreArchivo();
+
+    /**
+     * Posicion y longitud del registro vigente con ese ID
+     * Permite a otros lectores (CanalizacionLecturas) leerlo por su cuenta
+     */
+    UbicacionRegistro ubicacion(int id);
+
+    /**
+     * Convierte los bytes de un registro completo (cabecera + cuerpo) a texto
+     * Es estatica y no toca el archivo: se puede usar desde otros hilos
+     */
+    static void decodificarTexto(string_view registro, string& salida);
+
+    /**
+     * Lee un solo campo del registro sin materializar los demas
+     * RETORNA: false si no existe o no tiene formato de estudiante
+     */
+    bool leerCampo(int id, CampoEstudiante campo, string& salida);
+
+    /**
+     * Lee solo la edad del registro (un byte)
+     * RETORNA: Edad o -1 si no existe o no tiene formato de estudiante
+     */
+    int leerEdad(int id);
+
+    /**
+     * Marca el registro como borrado (un byte escrito en su lugar)
+     * RETORNA: false si el registro no existia
+     */
+    bool marcarBorrado(int id);
+
+    /**
+     * Copia un registro vigente de otro archivo con un ID nuevo
+     * El cuerpo se copia tal cual, sin decodificarlo
+     * RETORNA: false si el registro no existe en el origen
+     */
+    bool copiarDe(ArchivoRegistros& origen, int idOrigen, int idNuevo);
+};
+
+// ===============================
+// CODIFICACIoN VARIABLE
+// ===============================
+
+void escribirVarint(string& destino, uint64_t valor){
+    while(valor >= 0x80){
+        destino.push_back((char)((valor & 0x7F) | 0x80));  // Quedan mas bytes
+        valor >>= 7;
+    }
+    destino.push_back((char)valor);               // Ultimo byte
+}
+
+bool leerVarint(string_view origen, size_t& pos, uint64_t& valor){
+    valor = 0;
+    for(int desplazamiento = 0; desplazamiento < 64; desplazamiento += 7){
+        if(pos >= origen.size()) return false;
+        unsigned char byte = (unsigned char)origen[pos++];
+        valor |= (uint64_t)(byte & 0x7F) << desplazamiento;
+        if((byte & 0x80) == 0) return true;
+    }
+    return false;                                 // Numero demasiado largo
+}
+
+uint64_t aZigZag(int64_t valor){
+    return ((uint64_t)valor << 1) ^ (uint64_t)(valor >> 63);
+}
+
+int64_t desdeZigZag(uint64_t valor){
+    return (int64_t)(valor >> 1) ^ -(int64_t)(valor & 1);
+}
+
+uint32_t calcularCrc32(string_view datos){
+    // Tabla de 256 entradas calculada una sola vez
+    static uint32_t tabla[256];
+    static bool lista = false;
+    if(!lista){
+        for(uint32_t i = 0; i < 256; i++){
+            uint32_t c = i;
+            for(int k = 0; k < 8; k++){
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            tabla[i] = c;
+        }
+        lista = true;
+    }
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for(char byte : datos){
+        crc = tabla[(crc ^ (unsigned char)byte) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// ===============================
+// IMPLEMENTACIoN DE ESTUDIANTE
+// ===============================
+
+string Estudiante::aTexto() const{
+    string texto;
+    texto.reserve(nombre.size() + carrera.size() + deporte.size() + 8);
+    texto.append(nombre).append(1, '|').append(carrera).append(1, '|');
+    texto.append(deporte).append(1, '|').append(to_string(edad));
+    return texto;
+}
+
+bool Estudiante::cabeEnFormatoBinario() const{
+    return nombre.size() <= 255 && carrera.size() <= 255 && deporte.size() <= 255 &&
+           edad >= 0 && edad <= 255;
+}
+
+bool Estudiante::separar(string_view texto, string_view partes[3], int& edad){
+    // Tres separadores: nombre | carrera | deporte | edad
+    size_t inicio = 0;
+    for(int i = 0; i < 3; i++){
+        size_t fin = texto.find('|', inicio);
+        if(fin == string_view::npos) return false;
+        partes[i] = texto.substr(inicio, fin - inicio);
+        if(partes[i].size() > 255) return false;        // No cabe en la longitud de un byte
+        inicio = fin + 1;
+    }
+
+    // La edad debe ser un numero canonico (sin ceros a la izquierda) entre 0 y 255
+    string_view numero = texto.substr(inicio);
+    if(numero.empty() || numero.size() > 3) return false;
+    if(numero.size() > 1 && numero[0] == '0') return false;
+    edad = 0;
+    for(char c : numero){
+        if(c < '0' || c > '9') return false;
+        edad = edad * 10 + (c - '0');
+    }
+    return edad <= 255;
+}
+
+bool Estudiante::desdeTexto(string_view texto, Estudiante& salida){
+    string_view partes[3];
+    int edad;
+    if(!separar(texto, partes, edad)) return false;
+
+    salida.nombre.assign(partes[0]);
+    salida.carrera.assign(partes[1]);
+    salida.deporte.assign(partes[2]);
+    salida.edad = edad;
+    return true;
+}
+
+// ===============================
+// IMPLEMENTACIoN DE ARCHIVO DE REGISTROS
+// ===============================
+
+ArchivoRegistros::ArchivoRegistros(): abierto(false), siguienteId(ID_BASE), finArchivo(0){
+#ifdef ARBOL_ESTADISTICAS
+    aperturas = 0;
+    bytesLeidos = 0;
+    bytesEscritos = 0;
+#endif
+}
+
+void ArchivoRegistros::escribirEntero32(char* destino, uint32_t valor){
+    for(int i = 0; i < 4; i++){
+        destino[i] = (char)((valor >> (8 * i)) & 0xFF);
+    }
+}
+
+uint32_t ArchivoRegistros::leerEntero32(const char* origen){
+    uint32_t valor = 0;
+    for(int i = 0; i < 4; i++){
+        valor |= (uint32_t)(unsigned char)origen[i] << (8 * i);
+    }
+    return valor;
+}
+
+bool ArchivoRegistros::abrir(const string& archivoBinario, const string& archivoTextoAnterior){
+    nombre = archivoBinario;
+
+    // Crear el archivo con su firma si no existe
+    bool nuevo = false;
+    {
+        ifstream prueba(nombre, ios::binary);
+        if(!prueba.is_open()){
+            ofstream crear(nombre, ios::binary);
+            crear.write(FIRMA, 4);
+            nuevo = true;
+        }
+    }
+
+    archivo.open(nombre, ios::in | ios::out | ios::binary);
+#ifdef ARBOL_ESTADISTICAS
+    aperturas++;
+#endif
+    abierto = archivo.is_open() && indexarArchivo();
+
+    // Primer uso: traer los registros del archivo de texto anterior
+    if(abierto && nuevo){
+        importarTexto(archivoTextoAnterior);
+    }
+    return abierto;
+}
+
+bool ArchivoRegistros::leerEn(long long pos, char* destino, size_t n){
+    archivo.clear();
+    archivo.seekg(pos);
+    archivo.read(destino, n);
+#ifdef ARBOL_ESTADISTICAS
+    bytesLeidos += archivo.gcount();
+#endif
+    return (size_t)archivo.gcount() == n;
+}
+
+bool ArchivoRegistros::indexarArchivo(){
+    char firma[4];
+    if(!leerEn(0, firma, 4) || string_view(firma, 4) != FIRMA){
+        return false;                             // No es un archivo de registros
+    }
+
+    // Recorrer cabeceras saltando los cuerpos
+    long long pos = 4;
+    char cabecera[TAM_CABECERA];
+    while(leerEn(pos, cabecera, TAM_CABECERA)){
+        int id = (int)leerEntero32(cabecera + 2);
+        unsigned int longitud = TAM_CABECERA + leerEntero32(cabecera + 6);
+
+        if(cabecera[0] == 1){                     // Solo se indexan los vigentes
+            indexar(id, pos, longitud);
+        }
+        if(id >= siguienteId){
+            siguienteId = id + 1;                 // Nunca reutilizar un ID del archivo
+        }
+        pos += longitud;
+    }
+
+    finArchivo = pos;
+    archivo.clear();
+    return true;
+}
+
+void ArchivoRegistros::importarTexto(const string& archivoTexto){
+    ifstream texto(archivoTexto);
+    string linea;
+
+    while(getline(texto, linea)){
+        size_t separador = linea.find('|');
+        if(separador == string::npos || separador == 0) continue;
+
+        // La linea debe comenzar con un ID numerico (las eliminadas empiezan con "ELIMINADO:")
+        int id = 0;
+        bool numerico = true;
+        for(size_t i = 0; i < separador && numerico; i++){
+            numerico = linea[i] >= '0' && linea[i] <= '9';
+            id = id * 10 + (linea[i] - '0');
+        }
+
+        if(numerico && id >= ID_BASE){
+            guardar(id, string_view(linea).substr(separador + 1));
+            if(id >= siguienteId){
+                siguienteId = id + 1;
+            }
+        }
+    }
+}
+
+void ArchivoRegistros::indexar(int id, long long posicion, unsigned int longitud){
+    if(id < ID_BASE) return;
+    size_t i = id - ID_BASE;
+    if(i >= desplazamientos.size()){
+        desplazamientos.resize(i + 1, -1);
+        longitudes.resize(i + 1, 0);
+    }
+    desplazamientos[i] = posicion;
+    longitudes[i] = longitud;
+}
+
+long long ArchivoRegistros::ubicar(int id){
+    if(id < ID_BASE || (size_t)(id - ID_BASE) >= desplazamientos.size()) return -1;
+    return desplazamientos[id - ID_BASE];
+}
+
+int ArchivoRegistros::nuevoId(){
+    return siguienteId++;
+}
+
+bool ArchivoRegistros::anexar(int id, uint8_t tipo, string_view cuerpo){
+    if(!abierto) return false;
+
+    char cabecera[TAM_CABECERA];
+    cabecera[0] = 1;                              // Vigente
+    cabecera[1] = (char)tipo;
+    escribirEntero32(cabecera + 2, (uint32_t)id);
+    escribirEntero32(cabecera + 6, (uint32_t)cuerpo.size());
+
+    archivo.clear();
+    archivo.seekp(finArchivo);
+    archivo.write(cabecera, TAM_CABECERA);
+    archivo.write(cuerpo.data(), cuerpo.size());
+    archivo.flush();                              // Visible de inmediato, como al cerrar el archivo
+
+    unsigned int longitud = TAM_CABECERA + cuerpo.size();
+    indexar(id, finArchivo, longitud);
+    finArchivo += longitud;
+#ifdef ARBOL_ESTADISTICAS
+    bytesEscritos += longitud;
+#endif
+    return archivo.good();
+}
+
+void ArchivoRegistros::codificar(string_view nombreEstudiante, string_view carrera, string_view deporte, int edad){
+    buffer.clear();
+    buffer.push_back((char)edad);
+    for(string_view campo : {nombreEstudiante, carrera, deporte}){
+        buffer.push_back((char)campo.size());    // Longitud en un byte
+        buffer.append(campo.data(), campo.size());
+    }
+}
+
+bool ArchivoRegistros::guardar(int id, string_view texto){
+    string_view partes[3];
+    int edad;
+    if(Estudiante::separar(texto, partes, edad)){
+        codificar(partes[0], partes[1], partes[2], edad);
+        return anexar(id, 1, buffer);
+    }
+    return anexar(id, 0, texto);                  // Texto libre
+}
+
+bool ArchivoRegistros::guardar(int id, const Estudiante& estudiante){
+    if(!estudiante.cabeEnFormatoBinario()){
+        return anexar(id, 0, estudiante.aTexto());  // No cabe en el formato compacto
+    }
+    codificar(estudiante.nombre, estudiante.carrera, estudiante.deporte, estudiante.edad);
+    return anexar(id, 1, buffer);
+}
+
+bool ArchivoRegistros::leerTexto(int id, string& salida){
+    long long pos = ubicar(id);
+    if(pos < 0) return false;
+
+    // Una sola lectura posicionada de cabecera + cuerpo
+    unsigned int longitud = longitudes[id - ID_BASE];
+    buffer.resize(longitud);
+    if(!leerEn(pos, &buffer[0], longitud)) return false;
+
+    decodificarTexto(buffer, salida);
+    return true;
+}
+
+void ArchivoRegistros::decodificarTexto(string_view registro, string& salida){
+    if(registro[1] == 0){                         // Texto libre
+        salida.assign(registro.substr(TAM_CABECERA));
+        return;
+    }
+
+    // Estudiante: reconstruir "nombre|carrera|deporte|edad"
+    const char* cuerpo = registro.data() + TAM_CABECERA;
+    int edad = (unsigned char)cuerpo[0];
+    size_t desplazamiento = 1;
+    salida.clear();
+    for(int campo = 0; campo < 3; campo++){
+        unsigned char len = (unsigned char)cuerpo[desplazamiento];
+        salida.append(cuerpo + desplazamiento + 1, len).append(1, '|');
+        desplazamiento += 1 + len;
+    }
+    salida.append(to_string(edad));
+}
+
+const string& ArchivoRegistros::nombreArchivo(){
+    return nombre;
+}
+
+UbicacionRegistro ArchivoRegistros::ubicacion(int id){
+    long long pos = ubicar(id);
+    if(pos < 0) return {0, 0};
+    return {pos, longitudes[id - ID_BASE]};
+}
+
+bool ArchivoRegistros::leerEstudiante(int id, Estudiante& salida){
+    long long pos = ubicar(id);
+    if(pos < 0) return false;
+
+    unsigned int longitud = longitudes[id - ID_BASE];
+    buffer.resize(longitud);
+    if(!leerEn(pos, &buffer[0], longitud)) return false;
+
+    if(buffer[1] == 0){                           // Texto libre: intentar interpretarlo
+        return Estudiante::desdeTexto(string_view(buffer).substr(TAM_CABECERA), salida);
+    }
+
+    const char* cuerpo = buffer.data() + TAM_CABECERA;
+    salida.edad = (unsigned char)cuerpo[0];
+    size_t desplazamiento = 1;
+    string* campos[3] = {&salida.nombre, &salida.carrera, &salida.deporte};
+    for(int campo = 0; campo < 3; campo++){
+        unsigned char len = (unsigned char)cuerpo[desplazamiento];
+        campos[campo]->assign(cuerpo + desplazamiento + 1, len);  // Reutiliza la memoria del campo
+        desplazamiento += 1 + len;
+    }
+    return true;
+}
+
+bool ArchivoRegistros::leerCampo(int id, CampoEstudiante campo, string& salida){
+    long long pos = ubicar(id);
+    if(pos < 0) return false;
+
+    char tipo[2];
+    if(!leerEn(pos, tipo, 2)) return false;
+    if(tipo[1] == 0){                             // Texto libre: se necesita el registro completo
+        Estudiante completo;
+        if(!leerEstudiante(id, completo)) return false;
+        switch(campo){
+            case CAMPO_NOMBRE:  salida = completo.nombre; break;
+            case CAMPO_CARRERA: salida = completo.carrera; break;
+            case CAMPO_DEPORTE: salida = completo.deporte; break;
+            default:            salida = to_string(completo.edad); break;
+        }
+        return true;
+    }
+
+    long long actual = pos + TAM_CABECERA;        // Inicio del cuerpo: byte de edad
+    if(campo == CAMPO_EDAD){
+        char edad;
+        if(!leerEn(actual, &edad, 1)) return false;
+        salida = to_string((unsigned char)edad);
+        return true;
+    }
+
+    // Saltar los campos anteriores leyendo solo sus longitudes
+    actual++;
+    for(int i = CAMPO_NOMBRE; ; i++){
+        char len;
+        if(!leerEn(actual, &len, 1)) return false;
+        if(i == campo){
+            salida.resize((unsigned char)len);
+            return len == 0 || leerEn(actual + 1, &salida[0], (unsigned char)len);
+        }
+        actual += 1 + (unsigned char)len;
+    }
+}
+
+int ArchivoRegistros::leerEdad(int id){
+    long long pos = ubicar(id);
+    if(pos < 0) return -1;
+
+    char cabecera[TAM_CABECERA + 1];              // Cabecera + byte de edad
+    if(!leerEn(pos, cabecera, TAM_CABECERA + 1)) return -1;
+    if(cabecera[1] == 1){
+        return (unsigned char)cabecera[TAM_CABECERA];
+    }
+
+    Estudiante completo;                          // Texto libre
+    return leerEstudiante(id, completo) ? completo.edad : -1;
+}
+
+bool ArchivoRegistros::marcarBorrado(int id){
+    long long pos = ubicar(id);
+    if(pos < 0) return false;
+
+    char estado = 0;                              // Borrado
+    archivo.clear();
+    archivo.seekp(pos);
+    archivo.write(&estado, 1);
+    archivo.flush();
+#ifdef ARBOL_ESTADISTICAS
+    bytesEscritos += 1;
+#endif
+
+    desplazamientos[id - ID_BASE] = -1;           // Ya no es legible
+    return archivo.good();
+}
+
+bool ArchivoRegistros::copiarDe(ArchivoRegistros& origen, int idOrigen, int idNuevo){
+    long long pos = origen.ubicar(idOrigen);
+    if(pos < 0) return false;
+
+    // Una lectura en el origen y una escritura al final de este archivo
+    string& registro = origen.buffer;
+    registro.resize(origen.longitudes[idOrigen - ID_BASE]);
+    if(!origen.leerEn(pos, &registro[0], registro.size())) return false;
+    return anexar(idNuevo, (uint8_t)registro[1], string_view(registro).substr(TAM_CABECERA));
+}
+
+#endif //REGISTROESTUDIANTE_H